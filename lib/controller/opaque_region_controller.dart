@@ -0,0 +1,106 @@
+import 'package:fl_linux_window_manager/fl_linux_window_manager.dart';
+import 'package:flutter/cupertino.dart';
+
+class OpaqueRegionController {
+  /// A list of global keys attached to the OpaqueRegion widgets.
+  ///
+  /// The widgets attched to this key are representing positive opaque regions,
+  /// that is the compositor can skip blending this region.
+  static final List<GlobalKey> _positiveRegionKeys = [];
+
+  /// A list of global keys attached to the OpaqueRegion widgets.
+  ///
+  /// The widgets attched to this key are representing negative opaque regions,
+  /// that is the region has translucent pixels inside a positive region.
+  static final List<GlobalKey> _negativeRegionKeys = [];
+
+  /// The window ID whose opaque region will be updated by this controller.
+  static String _windowId = 'main';
+
+  /// Configure the controller to target the opaque region of the given window.
+  ///
+  /// Each Flutter window runs in its own isolate, so invoking this from the
+  /// respective window isolate will scope all subsequent opaque region updates
+  /// to that window only.
+  static void configure({required String windowId}) {
+    _windowId = windowId;
+  }
+
+  /// Adds a global key to the list of keys.
+  static void addKey(
+    GlobalKey key, {
+    bool isNegative = false,
+  }) {
+    if (isNegative) {
+      _negativeRegionKeys.add(key);
+    } else {
+      _positiveRegionKeys.add(key);
+    }
+  }
+
+  /// Removes a global key from the list of keys.
+  static void removeKey(GlobalKey key, {bool isNegative = false}) {
+    if (isNegative) {
+      _negativeRegionKeys.remove(key);
+    } else {
+      _positiveRegionKeys.remove(key);
+    }
+  }
+
+  /// This will be called whenever there is a change in the OpaqueRegion widget.
+  /// like size change, position change, etc.
+  ///
+  /// This will replace the native window opaque region with the new opaque region.
+  /// A stale opaque region shows the garbage below the window, so the region is
+  /// rebuilt from the current widgets. The changes are applied together with the
+  /// next frame of the window.
+  static void refreshOpaqueRegion() {
+    FlLinuxWindowManager.instance.clearOpaqueRegion(windowId: _windowId);
+
+    /// Sort the keys based on the depth of the widget.
+    final List<({GlobalKey key, bool isNegative})> keys = [
+      ..._positiveRegionKeys.map((key) => (key: key, isNegative: false)),
+      ..._negativeRegionKeys.map((key) => (key: key, isNegative: true)),
+    ];
+    keys.sort((a, b) => _findDepth(a.key).compareTo(_findDepth(b.key)));
+
+    for (final item in keys) {
+      /// Skip the widgets that are not mounted yet.
+      final renderObject = item.key.currentContext?.findRenderObject();
+      if (renderObject is! RenderBox || !renderObject.hasSize) {
+        continue;
+      }
+
+      /// Get the size and position of the widget.
+      final size = renderObject.size;
+      final position = renderObject.localToGlobal(Offset.zero);
+
+      /// Set the opaque region to the size and position of the widget.
+      final Rect region = Rect.fromLTWH(
+        position.dx,
+        position.dy,
+        size.width,
+        size.height,
+      );
+
+      if (item.isNegative) {
+        FlLinuxWindowManager.instance
+            .subtractOpaqueRegion(opaqueRegion: region, windowId: _windowId);
+      } else {
+        FlLinuxWindowManager.instance
+            .addOpaqueRegion(opaqueRegion: region, windowId: _windowId);
+      }
+    }
+  }
+
+  /// Find the depth of the OpaqueRegion widget with the given key.
+  static int _findDepth(GlobalKey key) {
+    /// If the key is not attached to any widget, then return -1.
+    if (key.currentContext == null || !key.currentContext!.mounted) {
+      return -1;
+    }
+
+    Element element = key.currentContext! as Element;
+    return element.depth;
+  }
+}
@@ -1,7 +1,18 @@
 import 'dart:developer';
+import 'dart:typed_data';
+import 'dart:ui' as ui;
 
+import 'package:fl_linux_window_manager/models/engine_options.dart';
+import 'package:fl_linux_window_manager/models/frame_stats.dart';
+import 'package:fl_linux_window_manager/models/input_mask_format.dart';
 import 'package:fl_linux_window_manager/models/keyboard_mode.dart';
 import 'package:fl_linux_window_manager/models/layer.dart';
+import 'package:fl_linux_window_manager/models/layer_options.dart';
+import 'package:fl_linux_window_manager/models/memory_usage.dart';
+import 'package:fl_linux_window_manager/models/monitor_info.dart';
+import 'package:fl_linux_window_manager/models/window_animation_curve.dart';
+import 'package:fl_linux_window_manager/models/window_event.dart';
+import 'package:fl_linux_window_manager/models/window_scale.dart';
 import 'package:flutter/services.dart';
 
 class FlLinuxWindowManager {
@@ -11,9 +22,28 @@ class FlLinuxWindowManager {
   /// A counter to the window IDs to keep track of the windows.
   static int _windowIdCounter = 1;
 
+  /// The argument that passes the entrypoint of a new window to its `main()`. This should match with
+  /// the prefix used in the platform side.
+  static const String _entrypointArgPrefix = '--flwm-entrypoint=';
+
+  /// A counter to the geometry animation IDs, to match the end events with the animations.
+  static int _animationIdCounter = 0;
+
   /// The method channel used to communicate with the platform side.
   final MethodChannel _methodChannel = const MethodChannel('fl_linux_window_manager');
 
+  /// The event channel used to receive the window events from the platform side.
+  final EventChannel _eventChannel = const EventChannel('fl_linux_window_manager/events');
+
+  /// The stream of events received by this engine. Created when listened for the first time.
+  Stream<WindowEvent>? _events;
+
+  /// The number of listeners to the events of each window, mapped with the window IDs.
+  final Map<String, int> _windowEventListeners = {};
+
+  /// The number of listeners to the events of all windows.
+  int _allWindowEventListeners = 0;
+
   /// Private constructor
   FlLinuxWindowManager._();
 
@@ -23,6 +53,82 @@ class FlLinuxWindowManager {
   /// Getter for the single instance of the class
   static FlLinuxWindowManager get instance => _instance;
 
+  /// The stream of all events received by this engine from the platform side.
+  Stream<WindowEvent> get _receivedEvents {
+    return _events ??= _eventChannel.receiveBroadcastStream().map((event) => WindowEvent.fromMap(event as Map<dynamic, dynamic>));
+  }
+
+  /// A stream of the events of all windows in the application.
+  ///
+  /// The platform side delivers the events of a window only to the engine of that window. While
+  /// this stream is listened, the events of all windows are also delivered to this engine, so
+  /// prefer [windowEvents] or [globalEvents] when only some of them are needed.
+  ///
+  /// The events are coalesced on the platform side, so a burst of events (e.g: configure events
+  /// while resizing) is received as a single event with the latest data.
+  Stream<WindowEvent> get events {
+    return _subscribedEvents(null);
+  }
+
+  /// A stream of the events of the window with the given window ID.
+  ///
+  /// While the stream is listened, the events of the window are delivered to this engine even if
+  /// the window belongs to another engine.
+  ///
+  /// The [windowId] is the ID of the window.
+  Stream<WindowEvent> windowEvents({String windowId = _mainWindowId}) {
+    return _subscribedEvents(windowId).where((event) => event.windowId == windowId);
+  }
+
+  /// A stream of the events that are not related to any window. (e.g:
+  /// [WindowEventType.monitorsChanged] and [WindowEventType.memoryPressure])
+  ///
+  /// These events are delivered to every engine, so listening to this stream does not add any
+  /// traffic.
+  Stream<WindowEvent> get globalEvents {
+    return _receivedEvents.where((event) => event.windowId.isEmpty);
+  }
+
+  /// Returns the events received by this engine, and subscribes to the events of the window with
+  /// the given ID (or all windows, if null) while the stream is listened.
+  Stream<WindowEvent> _subscribedEvents(String? windowId) {
+    return Stream.multi((controller) {
+      _updateEventSubscriptions(windowId, 1);
+
+      final subscription = _receivedEvents.listen(controller.addSync, onError: controller.addErrorSync, onDone: controller.closeSync);
+      controller.onCancel = () {
+        _updateEventSubscriptions(windowId, -1);
+        return subscription.cancel();
+      };
+    });
+  }
+
+  /// Add the given change to the listener count of the window with the given ID (or all windows,
+  /// if null), and send the subscriptions to the platform side when the first listener is added
+  /// or the last one is removed.
+  void _updateEventSubscriptions(String? windowId, int change) {
+    int count;
+    if (windowId == null) {
+      count = _allWindowEventListeners += change;
+    } else {
+      count = (_windowEventListeners[windowId] ?? 0) + change;
+      if (count == 0) {
+        _windowEventListeners.remove(windowId);
+      } else {
+        _windowEventListeners[windowId] = count;
+      }
+    }
+
+    if (count != (change > 0 ? 1 : 0)) {
+      return;
+    }
+
+    _methodChannel.invokeMethod('setEventSubscriptions', {
+      'windowIds': _windowEventListeners.keys.toList(),
+      'allWindows': _allWindowEventListeners > 0,
+    });
+  }
+
   /// Returns if the window with the given window ID is used.
   ///
   /// The [windowId] is the ID of the window.
@@ -37,22 +143,158 @@ class FlLinuxWindowManager {
   /// The [width] is the width of the window.
   /// The [height] is the height of the window.
   /// The [isLayer] is a flag to indicate if the window is a layer window.
+  /// The [entrypoint] is the name of the function that the new engine runs instead of the rest of
+  /// `main()`. (See [runEntrypoint])
+  /// The [initialPayload] is kept by the plugin until the new window takes it with
+  /// [takeInitialPayload]. It can be any value supported by the standard message codec, and it
+  /// is not encoded into the [args].
+  /// The [monitor] is the index of the monitor on which the layer window is shown. If not provided
+  /// the compositor will choose the monitor.
+  /// The [layerOptions] are the initial layer shell state of the layer window. Set them here
+  /// instead of calling [setLayer], [setLayerAnchor], etc. after the window is created.
+  /// If [deferEngine] is true, the window is created hidden and its flutter engine is started when
+  /// it is first shown with [showWindow]. This makes creating windows for later use cheap.
+  /// If [preloadEngine] is also true, the engine is started in the background when the application
+  /// is idle, so that showing the window is fast.
+  /// If [transparent] is true, the window is created with a transparent background. This is set
+  /// up before the window is shown, so the first frame is not drawn opaque. (Prefer this over
+  /// [enableTransparency] for the new windows)
+  /// The [engineOptions] are applied when the engine of the window is started.
+  /// The [windowId] is the ID of the window. If not provided a unique ID will be generated
+  /// and returned as the result.
+  ///
+  /// Returns a future with the window ID of the created window.
+  Future<String> createWindow({required String title, required int width, required int height, bool isLayer = false, List<String> args = const [], String? entrypoint, Object? initialPayload, int? monitor, LayerOptions layerOptions = const LayerOptions(), bool deferEngine = false, bool preloadEngine = false, bool transparent = false, EngineOptions engineOptions = const EngineOptions(), String? windowId}) async {
+    /// Setup the window ID for the new window
+    windowId ??= 'window_$_windowIdCounter';
+
+    /// Increment the window ID counter
+    _windowIdCounter++;
+
+    await _methodChannel.invokeMethod('createWindow', {'title': title, 'width': width, 'height': height, 'isLayer': isLayer, 'args': args, 'entrypoint': entrypoint, 'initialPayload': initialPayload, 'monitor': monitor, ...layerOptions.toMap(), 'deferEngine': deferEngine, 'preloadEngine': preloadEngine, 'transparent': transparent, ...engineOptions.toMap(), 'windowId': windowId});
+
+    return windowId;
+  }
+
+  /// Create a layer window without a flutter engine, that only paints the given color.
+  ///
+  /// Use it for the windows that do not need any widgets. (e.g: Screen edge hot zones, scrims
+  /// behind modals and solid color strips) It is drawn by GTK into a shared memory buffer, so it
+  /// costs a small fraction of the memory and startup time of a window with an engine.
+  ///
+  /// The layer, size, monitor, input region and visibility of the window are set with the same
+  /// methods as the other windows.
+  ///
+  /// The [color] is the color of the window. It can be transparent. (e.g: For an invisible hot zone)
+  /// The [eventWindowId] is the ID of the window whose engine receives the
+  /// [WindowEventType.pointerEnter] and [WindowEventType.pointerLeave] events of the native window.
+  /// Listen to them with `windowEvents(windowId: nativeWindowId)` in that engine.
+  /// The [monitor] is the index of the monitor on which the window is shown. If not provided the
+  /// compositor will choose the monitor.
+  /// The [layerOptions] are the initial layer shell state of the window.
   /// The [windowId] is the ID of the window. If not provided a unique ID will be generated
   /// and returned as the result.
   ///
   /// Returns a future with the window ID of the created window.
-  Future<String> createWindow({required String title, required int width, required int height, bool isLayer = false, List<String> args = const [], String? windowId}) async {
+  Future<String> createNativeWindow({required int width, required int height, ui.Color color = const ui.Color(0x00000000), String eventWindowId = _mainWindowId, String title = '', int? monitor, LayerOptions layerOptions = const LayerOptions(), String? windowId}) async {
     /// Setup the window ID for the new window
     windowId ??= 'window_$_windowIdCounter';
 
     /// Increment the window ID counter
     _windowIdCounter++;
 
-    await _methodChannel.invokeMethod('createWindow', {'title': title, 'width': width, 'height': height, 'isLayer': isLayer, 'args': args, 'windowId': windowId});
+    await _methodChannel.invokeMethod('createNativeWindow', {'title': title, 'width': width, 'height': height, 'isLayer': true, 'color': color.toARGB32(), 'eventWindowId': eventWindowId, 'monitor': monitor, ...layerOptions.toMap(), 'windowId': windowId});
 
     return windowId;
   }
 
+  /// Set the color of the native window with the given window ID. (See [createNativeWindow])
+  ///
+  /// The [color] is the new color of the window.
+  /// The [windowId] is the ID of the window.
+  Future<void> setNativeWindowColor({required ui.Color color, String windowId = _mainWindowId}) {
+    return _methodChannel.invokeMethod('setNativeWindowColor', {'color': color.toARGB32(), 'windowId': windowId});
+  }
+
+  /// Run the entrypoint given to [createWindow] for this engine, if any.
+  ///
+  /// The engines of the new windows always start from `main()`. Call this at the beginning of
+  /// `main()`, before the initialization of the app, so that the secondary windows run only the
+  /// code they need:
+  ///
+  /// ```dart
+  /// void main(List<String> args) {
+  ///   if (FlLinuxWindowManager.runEntrypoint(args, {'popup': popupMain})) return;
+  ///
+  ///   // The initialization of the main window...
+  /// }
+  /// ```
+  ///
+  /// The entrypoint is called with the rest of the [args]. Returns true if an entrypoint is run.
+  static bool runEntrypoint(List<String> args, Map<String, void Function(List<String> args)> entrypoints) {
+    if (args.isEmpty || !args.first.startsWith(_entrypointArgPrefix)) {
+      return false;
+    }
+
+    final name = args.first.substring(_entrypointArgPrefix.length);
+    final entrypoint = entrypoints[name];
+    if (entrypoint == null) {
+      throw ArgumentError.value(name, 'entrypoint', 'The entrypoint is not registered');
+    }
+
+    entrypoint(args.sublist(1));
+    return true;
+  }
+
+  /// Returns the initial payload given to [createWindow] for the window of this engine.
+  ///
+  /// The payload is released by the plugin when it is taken, so this returns null when it is
+  /// called again, or when the window is created without a payload.
+  Future<Object?> takeInitialPayload() {
+    return _methodChannel.invokeMethod<Object?>('takeInitialPayload');
+  }
+
+  /// Create a layer window on every monitor, with the given title, width, and height.
+  ///
+  /// An instance of the window is created for each monitor, and the instances are created or hidden
+  /// automatically when the monitors are connected or disconnected. The hidden instances are reused
+  /// for the new monitors, so that their engines do not need to be started again.
+  ///
+  /// The [args] are passed to each instance. The instances get their own window IDs, use
+  /// [getReplicatedWindowInstances] to get them.
+  /// The [layerOptions] are the initial layer shell state of each instance.
+  /// The [windowId] is the ID of the replicated window. If not provided a unique ID will be generated
+  /// and returned as the result.
+  ///
+  /// Returns a future with the ID of the replicated window.
+  Future<String> createReplicatedWindow({required String title, required int width, required int height, List<String> args = const [], LayerOptions layerOptions = const LayerOptions(), String? windowId}) async {
+    /// Setup the window ID for the new window
+    windowId ??= 'window_$_windowIdCounter';
+
+    /// Increment the window ID counter
+    _windowIdCounter++;
+
+    await _methodChannel.invokeMethod('createReplicatedWindow', {'title': title, 'width': width, 'height': height, 'isLayer': true, 'args': args, ...layerOptions.toMap(), 'windowId': windowId});
+
+    return windowId;
+  }
+
+  /// Close all instances of the replicated window with the given ID.
+  ///
+  /// The [windowId] is the ID of the replicated window.
+  Future<void> closeReplicatedWindow({required String windowId}) {
+    return _methodChannel.invokeMethod('closeReplicatedWindow', {'windowId': windowId});
+  }
+
+  /// Returns the window IDs of the visible instances of the replicated window with the given ID,
+  /// mapped to the index of the monitor on which the instance is shown.
+  ///
+  /// The [windowId] is the ID of the replicated window.
+  Future<Map<String, int>> getReplicatedWindowInstances({required String windowId}) async {
+    final result = await _methodChannel.invokeMethod<Map<dynamic, dynamic>>('getReplicatedWindowInstances', {'windowId': windowId});
+    return result?.cast<String, int>() ?? {};
+  }
+
   /// Set the layer of the window with the given window ID.
   ///
   /// The [layer] is the layer to set the window to.
@@ -72,12 +314,27 @@ class FlLinuxWindowManager {
 
   /// Set the title of the window with the given window ID.
   ///
+  /// The namespace of a layer window is not changed with the title, so updating the title does not
+  /// remap the window. (See [setLayerNamespace])
+  ///
   /// The [title] is the title of the window.
   /// The [windowId] is the ID of the window.
   Future<void> setTitle({required String title, String windowId = _mainWindowId}) {
     return _methodChannel.invokeMethod('setTitle', {'title': title, 'windowId': windowId});
   }
 
+  /// Set the namespace of the layer window with the given window ID. The compositor uses the
+  /// namespace to identify the kind of the window. (e.g: In the layer rules)
+  ///
+  /// The namespace of a shown layer surface cannot be changed, so the window is hidden and shown
+  /// again. Prefer setting it once with [LayerOptions.layerNamespace] in [createWindow].
+  ///
+  /// The [layerNamespace] is the namespace of the layer.
+  /// The [windowId] is the ID of the window.
+  Future<void> setLayerNamespace({required String layerNamespace, String windowId = _mainWindowId}) {
+    return _methodChannel.invokeMethod('setLayerNamespace', {'layerNamespace': layerNamespace, 'windowId': windowId});
+  }
+
   /// Set the margin for the layer with the given window ID.
   ///
   /// The [left] is the left margin of the layer.
@@ -149,13 +406,27 @@ class FlLinuxWindowManager {
 
   /// Hides and window with the given window ID.
   ///
+  /// The app lifecycle state of the window's engine is paused while it is hidden, so the framework
+  /// stops scheduling frames. It is resumed when the window is shown again.
+  ///
+  /// If [notifyMemoryPressure] is true, the engine is also told that the memory is low, so that the
+  /// framework releases its caches. (e.g: The image cache)
+  ///
+  /// If [soft] is true, a transparent layer window (See [createWindow]) is hidden without unmapping
+  /// its surface. It draws nothing, takes no input or keyboard focus and reserves no exclusive
+  /// zone, but the compositor keeps it configured, so [showWindow] shows it with a single commit
+  /// instead of a new configure round trip. Its engine is not paused, so the window shows its
+  /// latest content. Use it for the windows that are toggled often. (e.g: A launcher) Other
+  /// windows are hidden as usual.
+  ///
   /// The [windowId] is the ID of the window.
-  Future<void> hideWindow({String windowId = _mainWindowId}) {
-    return _methodChannel.invokeMethod('hideWindow', {'windowId': windowId});
+  Future<void> hideWindow({bool notifyMemoryPressure = false, bool soft = false, String windowId = _mainWindowId}) {
+    return _methodChannel.invokeMethod(
+        'hideWindow', {'notifyMemoryPressure': notifyMemoryPressure, 'soft': soft, 'windowId': windowId});
   }
 
   /// Shows the window with the given window ID.
-  /// If the window is hidden, then it will be shown.
+  /// If the window is hidden, then it will be shown. (Also after a soft hide)
   ///
   /// The [windowId] is the ID of the window.
   Future<void> showWindow({String windowId = _mainWindowId}) {
@@ -202,19 +473,288 @@ class FlLinuxWindowManager {
   /// Add a given rect to the input region of the window with the given window ID.
   /// The rect is relative to the window.
   ///
+  /// The input region changes are applied with the next frame of the window, so the changes
+  /// made in the same frame take effect together with the frame drawn for them.
+  ///
+  /// The region of the compositor is in integer logical pixels, so the rect is expanded to the
+  /// pixels that it partially covers.
+  ///
   /// The [inputRegion] is the rect to add to the input region.
   /// The [windowId] is the ID of the window.
   Future<void> addInputRegion({required Rect inputRegion, String windowId = _mainWindowId}) {
-    return _methodChannel.invokeMethod('addInputRegion', {'x': inputRegion.left.toInt(), 'y': inputRegion.top.toInt(), 'width': inputRegion.width.toInt(), 'height': inputRegion.height.toInt(), 'windowId': windowId});
+    final left = inputRegion.left.floor();
+    final top = inputRegion.top.floor();
+
+    return _methodChannel.invokeMethod('addInputRegion', {'x': left, 'y': top, 'width': inputRegion.right.ceil() - left, 'height': inputRegion.bottom.ceil() - top, 'windowId': windowId});
   }
 
   /// Subtract a given rect from the input region of the window with the given window ID.
   /// The rect is relative to the window.
   ///
+  /// The region of the compositor is in integer logical pixels, so the rect is shrunk to the
+  /// pixels that it fully covers. So that the pixels shared with an added region keep the input.
+  ///
   /// The [inputRegion] is the rect to subtract from the input region.
   /// The [windowId] is the ID of the window.
   Future<void> subtractInputRegion({required Rect inputRegion, String windowId = _mainWindowId}) {
-    return _methodChannel.invokeMethod('subtractInputRegion', {'x': inputRegion.left.toInt(), 'y': inputRegion.top.toInt(), 'width': inputRegion.width.toInt(), 'height': inputRegion.height.toInt(), 'windowId': windowId});
+    final left = inputRegion.left.ceil();
+    final top = inputRegion.top.ceil();
+    final width = inputRegion.right.floor() - left;
+    final height = inputRegion.bottom.floor() - top;
+
+    return _methodChannel.invokeMethod('subtractInputRegion', {'x': left, 'y': top, 'width': width < 0 ? 0 : width, 'height': height < 0 ? 0 : height, 'windowId': windowId});
+  }
+
+  /// Remove the opaque region of the window with the given window ID, so that the compositor
+  /// blends the whole window with the content below it.
+  ///
+  /// The [windowId] is the ID of the window.
+  Future<void> clearOpaqueRegion({String windowId = _mainWindowId}) {
+    return _methodChannel.invokeMethod('clearOpaqueRegion', {'windowId': windowId});
+  }
+
+  /// Add a given rect to the opaque region of the window with the given window ID.
+  /// The rect is relative to the window.
+  ///
+  /// The compositor does not draw the content below the opaque region of a transparent window,
+  /// so the rect must not have any translucent pixels. The region of the compositor is in
+  /// integer logical pixels, so the rect is shrunk to the pixels that it fully covers.
+  ///
+  /// The [opaqueRegion] is the rect to add to the opaque region.
+  /// The [windowId] is the ID of the window.
+  Future<void> addOpaqueRegion({required Rect opaqueRegion, String windowId = _mainWindowId}) {
+    final left = opaqueRegion.left.ceil();
+    final top = opaqueRegion.top.ceil();
+    final width = opaqueRegion.right.floor() - left;
+    final height = opaqueRegion.bottom.floor() - top;
+
+    return _methodChannel.invokeMethod('addOpaqueRegion', {'x': left, 'y': top, 'width': width < 0 ? 0 : width, 'height': height < 0 ? 0 : height, 'windowId': windowId});
+  }
+
+  /// Subtract a given rect from the opaque region of the window with the given window ID.
+  /// The rect is relative to the window.
+  ///
+  /// The rect is expanded to the pixels that it partially covers, so that no translucent pixel
+  /// is left in the opaque region.
+  ///
+  /// The [opaqueRegion] is the rect to subtract from the opaque region.
+  /// The [windowId] is the ID of the window.
+  Future<void> subtractOpaqueRegion({required Rect opaqueRegion, String windowId = _mainWindowId}) {
+    final left = opaqueRegion.left.floor();
+    final top = opaqueRegion.top.floor();
+
+    return _methodChannel.invokeMethod('subtractOpaqueRegion', {'x': left, 'y': top, 'width': opaqueRegion.right.ceil() - left, 'height': opaqueRegion.bottom.ceil() - top, 'windowId': windowId});
+  }
+
+  /// Replace the input region of the window with the given window ID, with the pixels of the
+  /// [mask] whose alpha is greater than [threshold]. So that the transparent parts of an
+  /// irregular shaped window let the input through.
+  ///
+  /// The mask is converted into rects on the platform side, and the region is committed only
+  /// if the rects are changed. So this can be called for every changed frame.
+  ///
+  /// The [width] and [height] are the size of the mask in pixels, and the [pixelRatio] is the
+  /// number of mask pixels in a logical pixel of the window. (e.g: The pixel ratio given to
+  /// [RenderRepaintBoundary.toImage])
+  /// The [windowId] is the ID of the window.
+  Future<void> setInputRegionMask({
+    required Uint8List mask,
+    required int width,
+    required int height,
+    InputMaskFormat format = InputMaskFormat.alpha8,
+    int threshold = 0,
+    double pixelRatio = 1.0,
+    String windowId = _mainWindowId,
+  }) {
+    return _methodChannel.invokeMethod('setInputRegionMask', {
+      'mask': mask,
+      'width': width,
+      'height': height,
+      'format': format.value,
+      'threshold': threshold,
+      'pixelRatio': pixelRatio,
+      'windowId': windowId,
+    });
+  }
+
+  /// Replace the input region of the window with the given window ID, with the pixels of the
+  /// [image] whose alpha is greater than [threshold]. (e.g: The last frame of a
+  /// [RepaintBoundary] read with [RenderRepaintBoundary.toImage])
+  ///
+  /// The [pixelRatio] is the number of image pixels in a logical pixel of the window. A lower
+  /// ratio sends less data, so the ratio of 1 is enough unless the input must follow the shape
+  /// more closely than a logical pixel.
+  /// The [windowId] is the ID of the window.
+  Future<void> setInputRegionFromImage(
+    ui.Image image, {
+    int threshold = 0,
+    double pixelRatio = 1.0,
+    String windowId = _mainWindowId,
+  }) async {
+    final pixels = await image.toByteData(format: ui.ImageByteFormat.rawRgba);
+    if (pixels == null) {
+      return;
+    }
+
+    return setInputRegionMask(
+      mask: pixels.buffer.asUint8List(pixels.offsetInBytes, pixels.lengthInBytes),
+      width: image.width,
+      height: image.height,
+      format: InputMaskFormat.rgba8,
+      threshold: threshold,
+      pixelRatio: pixelRatio,
+      windowId: windowId,
+    );
+  }
+
+  /// Returns the scale of the window with the given window ID.
+  ///
+  /// On outputs with a fractional scale (e.g: 1.25), [WindowScale.scale] is the exact scale
+  /// of the output, while the window is rendered at the next integer scale.
+  ///
+  /// The [windowId] is the ID of the window.
+  Future<WindowScale> getScale({String windowId = _mainWindowId}) async {
+    final scale = await _methodChannel.invokeMethod<Map<dynamic, dynamic>>('getScale', {'windowId': windowId});
+    return WindowScale.fromMap(scale!);
+  }
+
+  /// A stream of the scale of the window with the given window ID, that emits whenever the
+  /// scale is changed. (e.g: The window is moved to a monitor with a different scale)
+  ///
+  /// The [windowId] is the ID of the window.
+  Stream<WindowScale> scaleChanges({String windowId = _mainWindowId}) {
+    return windowEvents(windowId: windowId).where((event) => event.type == WindowEventType.scaleChanged).map((event) => WindowScale.fromMap(event.data));
+  }
+
+  /// Start or stop collecting the frame timing of the window with the given window ID.
+  ///
+  /// While enabled, the statistics are sent periodically through [frameStats]. Enabling it again
+  /// resets the statistics.
+  ///
+  /// The [windowId] is the ID of the window.
+  Future<void> setFrameTelemetry({required bool enabled, String windowId = _mainWindowId}) {
+    return _methodChannel.invokeMethod('setFrameTelemetry', {'enabled': enabled, 'windowId': windowId});
+  }
+
+  /// Returns the frame timing statistics of the window with the given window ID.
+  ///
+  /// The [windowId] is the ID of the window.
+  Future<FrameStats> getFrameStats({String windowId = _mainWindowId}) async {
+    final stats = await _methodChannel.invokeMethod<Map<dynamic, dynamic>>('getFrameStats', {'windowId': windowId});
+    return FrameStats.fromMap(stats!);
+  }
+
+  /// A stream of the frame timing statistics of the window with the given window ID.
+  ///
+  /// The [windowId] is the ID of the window.
+  Stream<FrameStats> frameStats({String windowId = _mainWindowId}) {
+    return windowEvents(windowId: windowId).where((event) => event.type == WindowEventType.frameStats).map((event) => FrameStats.fromMap(event.data));
+  }
+
+  /// Animate the size, layer margins and exclusive zone of the window with the given window ID.
+  ///
+  /// The animation is run on the platform side, on the frames of the window. So it stays smooth
+  /// even when the dart code is busy. Only the given values are animated. A running animation
+  /// of the window is stopped first.
+  ///
+  /// If the window is hidden while the animation is running, the target is applied right away.
+  ///
+  /// Returns true if the animation reached the target, and false if it is stopped or the window
+  /// is closed.
+  ///
+  /// The [windowId] is the ID of the window.
+  Future<bool> animateGeometry({
+    int? width,
+    int? height,
+    int? marginLeft,
+    int? marginTop,
+    int? marginRight,
+    int? marginBottom,
+    int? exclusiveZone,
+    required Duration duration,
+    WindowAnimationCurve curve = WindowAnimationCurve.easeInOut,
+    String windowId = _mainWindowId,
+  }) async {
+    final animationId = ++_animationIdCounter;
+
+    // Listen before starting, so that the end event is not missed.
+    final end = windowEvents(windowId: windowId).firstWhere(
+        (event) => event.type == WindowEventType.geometryAnimationEnd && event.data['animationId'] == animationId);
+
+    await _methodChannel.invokeMethod('animateGeometry', {
+      'animationId': animationId,
+      'width': width,
+      'height': height,
+      'marginLeft': marginLeft,
+      'marginTop': marginTop,
+      'marginRight': marginRight,
+      'marginBottom': marginBottom,
+      'exclusiveZone': exclusiveZone,
+      'durationMs': duration.inMilliseconds,
+      'curve': curve.value,
+      'windowId': windowId,
+    });
+
+    final event = await end;
+    return event.data['completed'] as bool? ?? false;
+  }
+
+  /// Stop the geometry animation of the window with the given window ID, at its current geometry.
+  ///
+  /// The [windowId] is the ID of the window.
+  Future<void> stopGeometryAnimation({String windowId = _mainWindowId}) {
+    return _methodChannel.invokeMethod('stopGeometryAnimation', {'windowId': windowId});
+  }
+
+  /// Returns the resident memory of the process, and how much it grew while the engine of each
+  /// window was started.
+  Future<MemoryUsage> getMemoryUsage() async {
+    final usage = await _methodChannel.invokeMethod<Map<dynamic, dynamic>>('getMemoryUsage');
+    return MemoryUsage.fromMap(usage!);
+  }
+
+  /// Start watching the memory pressure of the system, using the pressure stall information
+  /// of the kernel. (Linux 4.20+)
+  ///
+  /// When some tasks are stalled on memory for [stallMs] milliseconds in [windowMs] milliseconds,
+  /// every engine is told to release its caches, the hidden windows marked as evictable by
+  /// [setEvictable] are closed, and a [WindowEventType.memoryPressure] event is emitted. (See
+  /// [globalEvents])
+  ///
+  /// The [windowMs] must be between 500 and 10000. Without CAP_SYS_RESOURCE (i.e: In a normal
+  /// user session) the kernel also requires it to be a multiple of 2000, and only Linux 6.5+
+  /// accepts the trigger at all.
+  ///
+  /// Returns false if the kernel does not support it, or the monitor cannot be started.
+  Future<bool> startMemoryMonitor({int stallMs = 300, int windowMs = 2000}) async {
+    final isStarted = await _methodChannel.invokeMethod<bool>('startMemoryMonitor', {
+      'stallMs': stallMs,
+      'windowMs': windowMs,
+    });
+    return isStarted ?? false;
+  }
+
+  /// Stop watching the memory pressure of the system.
+  Future<void> stopMemoryMonitor() {
+    return _methodChannel.invokeMethod('stopMemoryMonitor');
+  }
+
+  /// Set if the window can be closed while it is hidden, when the system is under memory
+  /// pressure. (See [startMemoryMonitor])
+  ///
+  /// The [windowId] is the ID of the window.
+  Future<void> setEvictable({required bool evictable, String windowId = _mainWindowId}) {
+    return _methodChannel.invokeMethod('setEvictable', {'evictable': evictable, 'windowId': windowId});
+  }
+
+  /// Returns the number of live objects owned by the plugin on the platform side, mapped with
+  /// their type names.
+  ///
+  /// This is meant for finding leaks. The counts should not grow while the application repeats
+  /// the same actions. (e.g: Creating and closing a window)
+  Future<Map<String, int>> getHandleCounts() async {
+    final counts = await _methodChannel.invokeMethod<Map<dynamic, dynamic>>('getHandleCounts');
+    return counts!.map((key, value) => MapEntry(key as String, value as int));
   }
 
   Future<List<String>> getMonitorList({String windowId = _mainWindowId}) async {
@@ -233,6 +773,23 @@ class FlLinuxWindowManager {
     }
   }
 
+  /// Returns the details of all monitors connected to the display.
+  ///
+  /// The list is cached on the platform side, so this is cheap to call. Use [monitorChanges]
+  /// to get notified when the monitors are changed instead of polling this.
+  Future<List<MonitorInfo>> getMonitors() async {
+    final List<dynamic>? monitors = await _methodChannel.invokeMethod<List<dynamic>>('getMonitors');
+    return monitors?.map((monitor) => MonitorInfo.fromMap(monitor as Map<dynamic, dynamic>)).toList() ?? [];
+  }
+
+  /// A stream of the monitor list, that emits whenever a monitor is added, removed or changed.
+  Stream<List<MonitorInfo>> get monitorChanges {
+    return globalEvents.where((event) => event.type == WindowEventType.monitorsChanged).map((event) {
+      final monitors = event.data['monitors'] as List<dynamic>;
+      return monitors.map((monitor) => MonitorInfo.fromMap(monitor as Map<dynamic, dynamic>)).toList();
+    });
+  }
+
   Future<void> setMonitor({
     String windowId = _mainWindowId,
     required int monitorId, // -1 to unset/default
@@ -243,4 +800,35 @@ class FlLinuxWindowManager {
       log('Failed to set monitor for window $windowId: $e');
     }
   }
+
+  /// Move the shown layer window with the given window ID to another monitor, without restarting
+  /// or pausing its engine.
+  ///
+  /// The window is remapped onto the target monitor, so it disappears from the old monitor while
+  /// it moves, and its first frame on the target monitor may be drawn at the old size.
+  ///
+  /// A transparent placeholder with the same layer, anchors, margins and exclusive zone is shown
+  /// on the target monitor first, so that the other windows there make room for it before the
+  /// window arrives, instead of being reflowed twice. The placeholder is removed once the window
+  /// draws its first frame there. The engine is not paused during the move.
+  ///
+  /// Returns true when the window is shown on the target monitor, and false if the window is not
+  /// a layer window, the monitor is not found, or the move is cancelled. (e.g: By hiding the
+  /// window or starting another move)
+  ///
+  /// The [monitor] is the index of the target monitor. (See [getMonitors])
+  /// The [windowId] is the ID of the window.
+  Future<bool> migrateToMonitor({required int monitor, String windowId = _mainWindowId}) async {
+    // Listen before starting, so that the end event is not missed.
+    final end = windowEvents(windowId: windowId).firstWhere((event) => event.type == WindowEventType.monitorMigrated);
+
+    final isStarted = await _methodChannel.invokeMethod<bool>('migrateToMonitor', {'monitor': monitor, 'windowId': windowId});
+    if (isStarted != true) {
+      end.ignore();
+      return false;
+    }
+
+    final event = await end;
+    return event.data['completed'] as bool? ?? false;
+  }
 }
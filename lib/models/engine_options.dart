@@ -0,0 +1,28 @@
+/// The options of the flutter engine of a window, applied when the engine is started.
+///
+/// The Dart VM is shared by all engines of the process, so the VM options (e.g: the old generation
+/// heap size) cannot be set for a single window. Set them for the whole process with the
+/// `FLUTTER_ENGINE_SWITCHES` environment variables instead.
+class EngineOptions {
+  /// If the startup of the engine is traced into the timeline.
+  final bool traceStartup;
+
+  /// The maximum size of the GPU resource cache of the engine in bytes. The engine picks the size
+  /// from the screen size if not set. Small windows can use a much smaller cache.
+  final int? resourceCacheMaxBytes;
+
+  /// Extra switches of the engine, without the leading `--`. (e.g: `trace-skia`)
+  /// The engine reads the switches only in the debug and profile builds.
+  final List<String> switches;
+
+  const EngineOptions({this.traceStartup = false, this.resourceCacheMaxBytes, this.switches = const []});
+
+  /// Create the map sent to the platform side.
+  Map<String, dynamic> toMap() {
+    return {
+      'traceStartup': traceStartup,
+      'resourceCacheMaxBytes': resourceCacheMaxBytes,
+      'engineSwitches': switches,
+    };
+  }
+}
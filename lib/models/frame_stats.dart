@@ -0,0 +1,65 @@
+/// The frame timing statistics of a window.
+class FrameStats {
+  /// If the frame timing is collected for the window.
+  final bool enabled;
+
+  /// The source of the timing. `presentation` if the compositor supports the presentation
+  /// time protocol, `frameCallback` otherwise.
+  final String source;
+
+  /// The number of frames presented on the screen.
+  final int presented;
+
+  /// The number of frames that are replaced by a newer frame before being presented.
+  final int discarded;
+
+  /// The number of refresh cycles missed between consecutive frames.
+  final int droppedFrames;
+
+  /// The longest interval between two consecutive frames in milliseconds.
+  final double maxFrameIntervalMs;
+
+  /// The refresh rate of the output on which the window is presented. (0 if not known)
+  final double refreshRate;
+
+  /// The upper bounds of the [frameIntervals] buckets in milliseconds.
+  final List<int> frameIntervalBoundsMs;
+
+  /// The histogram of the intervals between consecutive frames. The last bucket counts the
+  /// intervals longer than the last bound of [frameIntervalBoundsMs].
+  final List<int> frameIntervals;
+
+  const FrameStats({
+    required this.enabled,
+    this.source = '',
+    this.presented = 0,
+    this.discarded = 0,
+    this.droppedFrames = 0,
+    this.maxFrameIntervalMs = 0,
+    this.refreshRate = 0,
+    this.frameIntervalBoundsMs = const [],
+    this.frameIntervals = const [],
+  });
+
+  /// Create the statistics from the map received from the platform side.
+  factory FrameStats.fromMap(Map<dynamic, dynamic> map) {
+    if (map['enabled'] != true) {
+      return const FrameStats(enabled: false);
+    }
+
+    return FrameStats(
+      enabled: true,
+      source: map['source'] as String,
+      presented: map['presented'] as int,
+      discarded: map['discarded'] as int,
+      droppedFrames: map['droppedFrames'] as int,
+      maxFrameIntervalMs: (map['maxFrameIntervalMs'] as num).toDouble(),
+      refreshRate: (map['refreshRate'] as num).toDouble(),
+      frameIntervalBoundsMs: (map['frameIntervalBoundsMs'] as List<dynamic>).cast<int>(),
+      frameIntervals: (map['frameIntervals'] as List<dynamic>).cast<int>(),
+    );
+  }
+
+  @override
+  String toString() => 'FrameStats($presented presented, $droppedFrames dropped, $discarded discarded)';
+}
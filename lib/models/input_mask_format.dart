@@ -0,0 +1,18 @@
+/// The pixel format of an input region mask.
+enum InputMaskFormat {
+  /// One byte of alpha per pixel.
+  alpha8(0),
+
+  /// Four bytes per pixel in the R, G, B, A order. (i.e: [ImageByteFormat.rawRgba])
+  rgba8(1),
+
+  /// One bit per pixel, the first pixel of a byte in the least significant bit. Each row starts
+  /// at a new byte.
+  bits(2);
+
+  /// Integer representation of the enum. This should match with the int value
+  /// of the platform side enum.
+  final int value;
+
+  const InputMaskFormat(this.value);
+}
@@ -0,0 +1,64 @@
+import 'package:fl_linux_window_manager/models/keyboard_mode.dart';
+import 'package:fl_linux_window_manager/models/layer.dart';
+
+/// The initial layer shell state of a layer window.
+///
+/// The state is applied before the window is first shown, so that the compositor configures the
+/// surface once with it. Setting the same state after [FlLinuxWindowManager.createWindow] makes
+/// the window jump, since each change reconfigures the shown surface.
+class LayerOptions {
+  final WindowLayer layer;
+
+  /// The edges the window is anchored to. (The values of [ScreenEdge] combined with the bitwise OR
+  /// operator)
+  final int anchor;
+
+  final int marginLeft;
+
+  final int marginTop;
+
+  final int marginRight;
+
+  final int marginBottom;
+
+  /// The length of the exclusive zone. (See [FlLinuxWindowManager.setLayerExclusiveZone])
+  final int exclusiveZone;
+
+  /// If the exclusive zone is calculated from the size of the window, instead of [exclusiveZone].
+  final bool autoExclusiveZone;
+
+  final KeyboardMode keyboardMode;
+
+  /// The namespace of the layer surface, which the compositor uses to identify the kind of the
+  /// window. (e.g: In the layer rules) The title of the window is used if not set.
+  final String? layerNamespace;
+
+  const LayerOptions({
+    this.layer = WindowLayer.top,
+    this.anchor = 0,
+    this.marginLeft = 0,
+    this.marginTop = 0,
+    this.marginRight = 0,
+    this.marginBottom = 0,
+    this.exclusiveZone = 0,
+    this.autoExclusiveZone = false,
+    this.keyboardMode = KeyboardMode.onDemand,
+    this.layerNamespace,
+  });
+
+  /// Create the map sent to the platform side.
+  Map<String, dynamic> toMap() {
+    return {
+      'layer': layer.layerId,
+      'anchor': anchor,
+      'marginLeft': marginLeft,
+      'marginTop': marginTop,
+      'marginRight': marginRight,
+      'marginBottom': marginBottom,
+      'exclusiveZone': exclusiveZone,
+      'autoExclusiveZone': autoExclusiveZone,
+      'keyboardMode': keyboardMode.value,
+      'layerNamespace': layerNamespace,
+    };
+  }
+}
@@ -0,0 +1,26 @@
+/// The memory usage of the application process.
+class MemoryUsage {
+  /// The resident memory of the process in bytes.
+  final int residentBytes;
+
+  /// The growth of the resident memory while the engine of each window was started, in bytes,
+  /// mapped with the window IDs. The windows created by the application itself are not included.
+  ///
+  /// This is the cost of starting the engine, not the memory used by it afterwards.
+  final Map<String, int> engineStartBytes;
+
+  const MemoryUsage({required this.residentBytes, required this.engineStartBytes});
+
+  /// Create the memory usage from the map received from the platform side.
+  factory MemoryUsage.fromMap(Map<dynamic, dynamic> map) {
+    final engines = map['engineStartBytes'] as Map<dynamic, dynamic>;
+
+    return MemoryUsage(
+      residentBytes: map['residentBytes'] as int,
+      engineStartBytes: engines.map((key, value) => MapEntry(key as String, value as int)),
+    );
+  }
+
+  @override
+  String toString() => 'MemoryUsage($residentBytes, $engineStartBytes)';
+}
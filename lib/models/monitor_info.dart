@@ -0,0 +1,66 @@
+import 'dart:ui';
+
+/// The details of a monitor connected to the display.
+class MonitorInfo {
+  /// The index of the monitor. This is the index used by [FlLinuxWindowManager.setMonitor].
+  final int index;
+
+  /// The connector name of the monitor. (e.g: DP-1, HDMI-A-1)
+  /// Empty if the compositor does not provide the connector names.
+  final String connector;
+
+  /// The manufacturer of the monitor.
+  final String manufacturer;
+
+  /// The model of the monitor.
+  final String model;
+
+  /// The position and size of the monitor in logical pixels.
+  final Rect geometry;
+
+  /// The area of the monitor that is not occupied by the exclusive zones of panels.
+  final Rect workarea;
+
+  /// The integer scale factor of the monitor.
+  final int scaleFactor;
+
+  /// The refresh rate of the monitor in Hertz. (0 if not known)
+  final double refreshRate;
+
+  const MonitorInfo({
+    required this.index,
+    required this.connector,
+    required this.manufacturer,
+    required this.model,
+    required this.geometry,
+    required this.workarea,
+    required this.scaleFactor,
+    required this.refreshRate,
+  });
+
+  /// Create the monitor details from the map received from the platform side.
+  factory MonitorInfo.fromMap(Map<dynamic, dynamic> map) {
+    return MonitorInfo(
+      index: map['index'] as int,
+      connector: map['connector'] as String,
+      manufacturer: map['manufacturer'] as String,
+      model: map['model'] as String,
+      geometry: _rectFromMap(map['geometry'] as Map<dynamic, dynamic>),
+      workarea: _rectFromMap(map['workarea'] as Map<dynamic, dynamic>),
+      scaleFactor: map['scaleFactor'] as int,
+      refreshRate: (map['refreshRate'] as num).toDouble(),
+    );
+  }
+
+  static Rect _rectFromMap(Map<dynamic, dynamic> map) {
+    return Rect.fromLTWH(
+      (map['x'] as int).toDouble(),
+      (map['y'] as int).toDouble(),
+      (map['width'] as int).toDouble(),
+      (map['height'] as int).toDouble(),
+    );
+  }
+
+  @override
+  String toString() => 'MonitorInfo($index, $connector, $model, $geometry)';
+}
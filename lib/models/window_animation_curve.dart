@@ -0,0 +1,13 @@
+/// The curve of a geometry animation that is run on the platform side.
+enum WindowAnimationCurve {
+  linear(0),
+  easeIn(1),
+  easeOut(2),
+  easeInOut(3);
+
+  /// Integer representation of the enum. This should match with the int value
+  /// of the platform side enum.
+  final int value;
+
+  const WindowAnimationCurve(this.value);
+}
@@ -0,0 +1,113 @@
+/// The type of an event that is received from a window.
+enum WindowEventType {
+  /// The window is configured with a new size by the compositor.
+  /// For layer windows, this is the final size given by the layer surface configure.
+  configure('configure'),
+
+  /// The window is mapped (shown) on the screen.
+  map('map'),
+
+  /// The window is unmapped (hidden) from the screen.
+  unmap('unmap'),
+
+  /// The window received the keyboard focus.
+  focusIn('focusIn'),
+
+  /// The window lost the keyboard focus.
+  focusOut('focusOut'),
+
+  /// The window entered a monitor.
+  monitorEnter('monitorEnter'),
+
+  /// The window left a monitor.
+  monitorLeave('monitorLeave'),
+
+  /// The window is closed.
+  closed('closed'),
+
+  /// The preferred scale of the window, or the scale of its buffers is changed.
+  scaleChanged('scaleChanged'),
+
+  /// The frame timing statistics of the window, sent periodically while the frame telemetry
+  /// is enabled for the window.
+  frameStats('frameStats'),
+
+  /// A geometry animation of the window is finished or stopped.
+  geometryAnimationEnd('geometryAnimationEnd'),
+
+  /// The monitors connected to the display are changed. This is not related to any window,
+  /// so the window ID of this event is empty.
+  monitorsChanged('monitorsChanged'),
+
+  /// The system is under memory pressure. This is not related to any window, so the window ID
+  /// of this event is empty.
+  memoryPressure('memoryPressure'),
+
+  /// The layer window is moved to another monitor, or the move is cancelled.
+  monitorMigrated('monitorMigrated'),
+
+  /// The pointer entered a native window. (See `createNativeWindow()`)
+  /// This is only sent to the engine of the event window of the native window.
+  pointerEnter('pointerEnter'),
+
+  /// The pointer left a native window. This is only sent to the engine of the event window of
+  /// the native window.
+  pointerLeave('pointerLeave'),
+
+  /// An event that is not known by this version of the plugin.
+  unknown('');
+
+  /// String representation of the enum. This should match with the event name
+  /// sent from the platform side.
+  final String value;
+
+  const WindowEventType(this.value);
+
+  /// Returns the event type with the given name.
+  static WindowEventType fromValue(String value) {
+    return WindowEventType.values.firstWhere((type) => type.value == value, orElse: () => WindowEventType.unknown);
+  }
+}
+
+/// An event received from a window.
+class WindowEvent {
+  /// The ID of the window that produced the event.
+  final String windowId;
+
+  /// The type of the event.
+  final WindowEventType type;
+
+  /// The extra data of the event.
+  ///
+  /// - [WindowEventType.configure] have `x`, `y`, `width` and `height`.
+  /// - [WindowEventType.monitorEnter] and [WindowEventType.monitorLeave] have `monitor`, the index
+  ///   of the monitor. (-1 if the monitor is already disconnected)
+  /// - [WindowEventType.scaleChanged] have `scale` and `bufferScale`. (See [WindowScale])
+  /// - [WindowEventType.frameStats] have the statistics. (See [FrameStats])
+  /// - [WindowEventType.geometryAnimationEnd] have `animationId` and `completed`, false if the
+  ///   animation is stopped before reaching the target.
+  /// - [WindowEventType.monitorsChanged] have `monitors`, the list of all monitors.
+  /// - [WindowEventType.memoryPressure] have `closedWindows`, the IDs of the evictable windows
+  ///   closed to release memory.
+  /// - [WindowEventType.monitorMigrated] have `monitor` and `completed`, false if the move is
+  ///   cancelled before the window is shown on the monitor.
+  /// - [WindowEventType.pointerEnter] and [WindowEventType.pointerLeave] have `x` and `y`, the
+  ///   position of the pointer in the native window.
+  final Map<String, dynamic> data;
+
+  const WindowEvent({required this.windowId, required this.type, this.data = const {}});
+
+  /// Create the event from the map received from the platform side.
+  factory WindowEvent.fromMap(Map<dynamic, dynamic> map) {
+    final data = map['data'] as Map<dynamic, dynamic>?;
+
+    return WindowEvent(
+      windowId: map['windowId'] as String,
+      type: WindowEventType.fromValue(map['event'] as String),
+      data: data?.cast<String, dynamic>() ?? const {},
+    );
+  }
+
+  @override
+  String toString() => 'WindowEvent($windowId, ${type.value}, $data)';
+}
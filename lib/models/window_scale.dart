@@ -0,0 +1,23 @@
+/// The scale of a window.
+class WindowScale {
+  /// The preferred scale of the window sent by the compositor. (e.g: 1.25, 1.5)
+  /// This is the same as [bufferScale] if the compositor does not support fractional scaling.
+  final double scale;
+
+  /// The integer scale of the buffers rendered for the window. The compositor scales the
+  /// buffers down to [scale] when it is fractional.
+  final int bufferScale;
+
+  const WindowScale({required this.scale, required this.bufferScale});
+
+  /// Create the window scale from the map received from the platform side.
+  factory WindowScale.fromMap(Map<dynamic, dynamic> map) {
+    return WindowScale(
+      scale: (map['scale'] as num).toDouble(),
+      bufferScale: map['bufferScale'] as int,
+    );
+  }
+
+  @override
+  String toString() => 'WindowScale($scale, $bufferScale)';
+}
@@ -0,0 +1,79 @@
+import 'package:fl_linux_window_manager/controller/opaque_region_controller.dart';
+import 'package:flutter/cupertino.dart';
+
+/// Marks the area of the child as fully opaque, so that the compositor does not
+/// blend the content below it. The child must not have any translucent pixels.
+/// (e.g: Rounded corners, shadows)
+///
+/// Use [OpaqueRegion.negative] to cut the translucent parts out of an opaque
+/// region.
+class OpaqueRegion extends StatefulWidget {
+  final Widget child;
+  final bool _isNegative;
+  final String? windowId;
+
+  const OpaqueRegion({super.key, required this.child, this.windowId})
+      : _isNegative = false;
+  const OpaqueRegion.negative({super.key, required this.child, this.windowId})
+      : _isNegative = true;
+
+  @override
+  State<OpaqueRegion> createState() => _OpaqueRegionState();
+}
+
+class _OpaqueRegionState extends State<OpaqueRegion> {
+  late final GlobalKey _key;
+
+  @override
+  void initState() {
+    super.initState();
+
+    /// Setup a new global key for this widget.
+    _key = GlobalKey();
+
+    if (widget.windowId != null) {
+      OpaqueRegionController.configure(windowId: widget.windowId!);
+    }
+
+    OpaqueRegionController.addKey(
+      _key,
+      isNegative: widget._isNegative,
+    );
+
+    /// Get the initial details of the widget after the initial frame.
+    /// and update the opaque region.
+    WidgetsBinding.instance.addPostFrameCallback((_) {
+      OpaqueRegionController.refreshOpaqueRegion();
+    });
+  }
+
+  @override
+  void dispose() {
+    /// Remove the opaque region key from the controller.
+    OpaqueRegionController.removeKey(
+      _key,
+      isNegative: widget._isNegative,
+    );
+    OpaqueRegionController.refreshOpaqueRegion();
+
+    super.dispose();
+  }
+
+  @override
+  Widget build(BuildContext context) {
+    return NotificationListener<SizeChangedLayoutNotification>(
+      onNotification: (notification) {
+        /// Update the opaque region when the size changes
+        WidgetsBinding.instance.addPostFrameCallback((_) {
+          OpaqueRegionController.refreshOpaqueRegion();
+        });
+
+        return false;
+      },
+      child: SizeChangedLayoutNotifier(
+        key: _key,
+        child: widget.child,
+      ),
+    );
+  }
+}
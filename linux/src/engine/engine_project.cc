@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <engine/engine_project.h>
+#include <logger/logger.h>
+
+/**
+ * Static member initialization
+ */
+FLWM::GObjectRef<FlDartProject> FLWM::EngineProject::project;
+int FLWM::EngineProject::processSwitchCount = -1;
+
+/**
+ * The environment variables from which the engine reads its switches.
+ * (FLUTTER_ENGINE_SWITCHES=N and FLUTTER_ENGINE_SWITCH_1..N)
+ */
+static constexpr const char *_switchCountKey = "FLUTTER_ENGINE_SWITCHES";
+
+std::string _switchKey(int index) {
+  return "FLUTTER_ENGINE_SWITCH_" + std::to_string(index);
+}
+
+FlDartProject *
+FLWM::EngineProject::acquire(const std::vector<std::string> &args,
+                             const std::string &entrypoint) {
+  if (project.get() == NULL) {
+    project.reset(fl_dart_project_new());
+    FLWM_LOG_DEBUG("Using the AOT library %s for the new engines",
+                   fl_dart_project_get_aot_library_path(project));
+  }
+
+  /// CLI arguments to be passed to the dart entrypoint main() function
+  /// The last item in this array must be a NULL pointer, to indicate the end of
+  /// the array items. Otherwise errors will occur.
+  std::vector<char *> cliArgs;
+
+  /// The embedder always runs main(), so the entrypoint is passed as the first
+  /// argument, and main() calls it through runEntrypoint() of the dart API.
+  std::string entrypointArg = entrypointArgPrefix + entrypoint;
+  if (!entrypoint.empty()) {
+    cliArgs.push_back(const_cast<char *>(entrypointArg.c_str()));
+  }
+
+  for (const std::string &arg : args) {
+    cliArgs.push_back(const_cast<char *>(arg.c_str()));
+  }
+  cliArgs.push_back(nullptr);
+
+  /// The project copies the arguments.
+  fl_dart_project_set_dart_entrypoint_arguments(project, cliArgs.data());
+
+  return project;
+}
+
+void FLWM::EngineProject::applySwitches(const EngineOptions &options) {
+  std::vector<std::string> switches = options.switches;
+  if (options.traceStartup) {
+    switches.push_back("trace-startup");
+  }
+
+  if (switches.empty()) {
+    return;
+  }
+
+  const char *countValue = g_getenv(_switchCountKey);
+  processSwitchCount = countValue != NULL ? atoi(countValue) : 0;
+
+  /// The switches of the window are added after the switches of the process.
+  int count = processSwitchCount;
+  for (const std::string &engineSwitch : switches) {
+    count++;
+    g_setenv(_switchKey(count).c_str(), engineSwitch.c_str(), TRUE);
+  }
+  g_setenv(_switchCountKey, std::to_string(count).c_str(), TRUE);
+}
+
+void FLWM::EngineProject::resetSwitches() {
+  if (processSwitchCount < 0) {
+    return;
+  }
+
+  const char *countValue = g_getenv(_switchCountKey);
+  int count = countValue != NULL ? atoi(countValue) : 0;
+  for (int i = processSwitchCount + 1; i <= count; i++) {
+    g_unsetenv(_switchKey(i).c_str());
+  }
+
+  if (processSwitchCount > 0) {
+    g_setenv(_switchCountKey, std::to_string(processSwitchCount).c_str(), TRUE);
+  } else {
+    g_unsetenv(_switchCountKey);
+  }
+  processSwitchCount = -1;
+}
+
+void FLWM::EngineProject::applyRuntimeOptions(FlView *view,
+                                              const EngineOptions &options) {
+  if (!options.resourceCacheMaxBytes.has_value()) {
+    return;
+  }
+
+  /// The engine handles this message itself, on the channel used by
+  /// SystemChannels.skia in the framework.
+  GObjectRef<FlPluginRegistrar> registrar(
+      fl_plugin_registry_get_registrar_for_plugin(FL_PLUGIN_REGISTRY(view),
+                                                  "FlLinuxWindowManagerPlugin"));
+  GObjectRef<FlJsonMethodCodec> codec(fl_json_method_codec_new());
+  GObjectRef<FlMethodChannel> channel(
+      fl_method_channel_new(fl_plugin_registrar_get_messenger(registrar),
+                            "flutter/skia", FL_METHOD_CODEC(codec.get())));
+
+  FlValueRef maxBytes(fl_value_new_int(*options.resourceCacheMaxBytes));
+  fl_method_channel_invoke_method(channel, "Skia.setResourceCacheMaxBytes",
+                                  maxBytes, NULL, NULL, NULL);
+}
+
+gint64 FLWM::EngineProject::getResidentBytes() {
+  FILE *file = fopen("/proc/self/statm", "r");
+  if (file == NULL) {
+    return 0;
+  }
+
+  /// The second field is the number of resident pages.
+  long size = 0, resident = 0;
+  int count = fscanf(file, "%ld %ld", &size, &resident);
+  fclose(file);
+
+  if (count != 2) {
+    return 0;
+  }
+
+  return (gint64)resident * sysconf(_SC_PAGESIZE);
+}
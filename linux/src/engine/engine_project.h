@@ -0,0 +1,94 @@
+#pragma once
+
+#include <gtk/gtk.h>
+#include <optional>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <flutter_linux/flutter_linux.h>
+#include <handles/handles.h>
+
+namespace FLWM
+{
+    /**
+     * The options of the engine of a window, that are applied when the engine is started.
+     */
+    struct EngineOptions
+    {
+        /**
+         * If the startup of the engine is traced into the timeline. (--trace-startup)
+         */
+        bool traceStartup = false;
+
+        /**
+         * The maximum size of the GPU resource cache of the engine in bytes. The engine picks the
+         * size from the screen size if not set.
+         */
+        std::optional<int64_t> resourceCacheMaxBytes;
+
+        /**
+         * Extra switches of the engine, without the leading "--". (e.g: "trace-skia")
+         * The engine reads the switches only in the debug and profile builds.
+         */
+        std::vector<std::string> switches;
+    };
+
+    /**
+     * Keeps a single FlDartProject for all engines started by the plugin.
+     *
+     * The project resolves the paths of the assets, the AOT library and the ICU data when it is
+     * created. Sharing it means they are resolved once, and every engine loads the same AOT
+     * library and ICU data files, so the mappings are shared by the engines.
+     */
+    class EngineProject
+    {
+    public:
+        /**
+         * The argument that passes the name of the entrypoint to the dart code.
+         * (e.g: --flwm-entrypoint=popupMain)
+         */
+        static constexpr const char *entrypointArgPrefix = "--flwm-entrypoint=";
+
+        /**
+         * Returns the shared project with the given dart entrypoint arguments, and the name of the
+         * entrypoint to run. (Empty to run main())
+         *
+         * The engine reads the arguments when it is started, so the project must be acquired again
+         * right before the engine of a view is started, if another window may have acquired it in
+         * between. (i.e: When the view is realized)
+         */
+        static FlDartProject *acquire(const std::vector<std::string> &args, const std::string &entrypoint);
+
+        /**
+         * Add the switches of the given options to the switches of the process, for the engine
+         * that is started next. The engine reads the switches from the environment when it is
+         * started, so they must be reset by resetSwitches() right after it.
+         */
+        static void applySwitches(const EngineOptions &options);
+
+        /**
+         * Restore the switches of the process changed by applySwitches().
+         */
+        static void resetSwitches();
+
+        /**
+         * Apply the options that are set through the messenger of the started engine.
+         */
+        static void applyRuntimeOptions(FlView *view, const EngineOptions &options);
+
+        /**
+         * Returns the resident memory of the process in bytes. (0 if it cannot be read)
+         */
+        static gint64 getResidentBytes();
+
+    private:
+        static GObjectRef<FlDartProject> project;
+
+        /**
+         * The number of switches set for the whole process, before applySwitches() changed it.
+         * (-1 if the switches are not changed)
+         */
+        static int processSwitchCount;
+    };
+}
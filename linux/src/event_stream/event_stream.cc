@@ -0,0 +1,188 @@
+#include <event_stream/event_stream.h>
+#include <logger/logger.h>
+
+/**
+ * Static member initialization
+ */
+std::map<std::string, FLWM::EventSink> FLWM::EventStream::sinks;
+std::vector<FLWM::PendingEvent> FLWM::EventStream::pendingEvents;
+guint FLWM::EventStream::flushSourceId = 0;
+
+void FLWM::EventStream::attach(std::string windowId,
+                               FlBinaryMessenger *messenger) {
+  /// An engine is registered only once for a window, but the window may get a
+  /// new engine. So remove the old channel, if any.
+  detach(windowId);
+
+  g_autoptr(FlStandardMethodCodec) codec = fl_standard_method_codec_new();
+  FLWM::GObjectRef<FlEventChannel> channel(
+      fl_event_channel_new(messenger, channelName, FL_METHOD_CODEC(codec)));
+
+  /// The window ID is used as the user data, to find the sink in the handlers.
+  fl_event_channel_set_stream_handlers(channel, onListen, onCancel,
+                                       g_strdup(windowId.c_str()), g_free);
+
+  EventSink sink;
+  sink.channel = std::move(channel);
+  sink.isListening = false;
+  sink.isAllWindows = false;
+
+  sinks[windowId] = std::move(sink);
+}
+
+void FLWM::EventStream::detach(std::string windowId) {
+  auto iter = sinks.find(windowId);
+  if (iter == sinks.end()) {
+    return;
+  }
+
+  sinks.erase(iter);
+}
+
+bool FLWM::EventStream::hasListeners() {
+  for (auto const &[id, sink] : sinks) {
+    if (sink.isListening) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void FLWM::EventStream::subscribe(std::string windowId,
+                                  std::vector<std::string> windowIds,
+                                  bool isAllWindows) {
+  auto iter = sinks.find(windowId);
+  if (iter == sinks.end()) {
+    return;
+  }
+
+  iter->second.windowIds =
+      std::set<std::string>(windowIds.begin(), windowIds.end());
+  iter->second.isAllWindows = isAllWindows;
+}
+
+bool FLWM::EventStream::isDeliveredTo(const std::string &sinkWindowId,
+                                      const EventSink &sink,
+                                      const std::string &targetWindowId,
+                                      const std::string &windowId) {
+  if (!sink.isListening) {
+    return false;
+  }
+
+  if (!targetWindowId.empty()) {
+    return sinkWindowId == targetWindowId;
+  }
+
+  /// The events that are not related to any window are sent to all engines.
+  if (windowId.empty() || sinkWindowId == windowId || sink.isAllWindows) {
+    return true;
+  }
+
+  return sink.windowIds.count(windowId) > 0;
+}
+
+void FLWM::EventStream::emit(std::string windowId, std::string name,
+                             FlValue *data) {
+  emitTo("", windowId, name, data);
+}
+
+void FLWM::EventStream::emitTo(std::string targetWindowId,
+                               std::string windowId, std::string name,
+                               FlValue *data) {
+  /// Nobody will receive the event, so drop it right away.
+  bool isListening = false;
+  for (auto const &[id, sink] : sinks) {
+    if (isDeliveredTo(id, sink, targetWindowId, windowId)) {
+      isListening = true;
+      break;
+    }
+  }
+
+  if (!isListening) {
+    if (data != nullptr) {
+      fl_value_unref(data);
+    }
+    return;
+  }
+
+  /// Coalesce the event with the previous pending event of the same name.
+  /// The old event is removed and the new one is added to the end, so that the
+  /// order of the events is still correct. (e.g: map, unmap, map -> unmap, map)
+  for (auto iter = pendingEvents.begin(); iter != pendingEvents.end(); ++iter) {
+    if (iter->windowId == windowId && iter->name == name) {
+      if (iter->data != nullptr) {
+        fl_value_unref(iter->data);
+      }
+      pendingEvents.erase(iter);
+      break;
+    }
+  }
+
+  PendingEvent event;
+  event.windowId = windowId;
+  event.name = name;
+  event.data = data;
+  event.targetWindowId = targetWindowId;
+  pendingEvents.push_back(event);
+
+  if (flushSourceId == 0) {
+    flushSourceId = g_timeout_add(coalesceIntervalMs, flush, NULL);
+  }
+}
+
+gboolean FLWM::EventStream::flush(gpointer userData) {
+  flushSourceId = 0;
+
+  /// Take the pending events, so that the events emitted while sending are
+  /// delivered in the next flush.
+  std::vector<PendingEvent> events;
+  events.swap(pendingEvents);
+
+  for (PendingEvent &event : events) {
+    g_autoptr(FlValue) value = fl_value_new_map();
+    fl_value_set_string_take(value, "windowId",
+                             fl_value_new_string(event.windowId.c_str()));
+    fl_value_set_string_take(value, "event",
+                             fl_value_new_string(event.name.c_str()));
+    fl_value_set_string_take(value, "data",
+                             event.data != nullptr ? event.data
+                                                   : fl_value_new_null());
+
+    for (auto const &[id, sink] : sinks) {
+      if (!isDeliveredTo(id, sink, event.targetWindowId, event.windowId)) {
+        continue;
+      }
+
+      g_autoptr(GError) error = nullptr;
+      if (!fl_event_channel_send(sink.channel, value, NULL, &error)) {
+        FLWM_LOG_WARNING("Failed to send the window event to %s: %s",
+                         id.c_str(), error->message);
+      }
+    }
+  }
+
+  return G_SOURCE_REMOVE;
+}
+
+FlMethodErrorResponse *FLWM::EventStream::onListen(FlEventChannel *channel,
+                                                   FlValue *args,
+                                                   gpointer userData) {
+  auto iter = sinks.find((const char *)userData);
+  if (iter != sinks.end()) {
+    iter->second.isListening = true;
+  }
+
+  return NULL;
+}
+
+FlMethodErrorResponse *FLWM::EventStream::onCancel(FlEventChannel *channel,
+                                                   FlValue *args,
+                                                   gpointer userData) {
+  auto iter = sinks.find((const char *)userData);
+  if (iter != sinks.end()) {
+    iter->second.isListening = false;
+  }
+
+  return NULL;
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <flutter_linux/flutter_linux.h>
+#include <handles/handles.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace FLWM
+{
+    /**
+     * The sink through which the events are delivered to the engine of a window.
+     */
+    struct EventSink
+    {
+        /**
+         * The event channel registered in the engine of the window.
+         */
+        GObjectRef<FlEventChannel> channel;
+
+        /**
+         * If the dart code of the window is currently listening to the event channel.
+         */
+        bool isListening;
+
+        /**
+         * The IDs of the other windows whose events are also delivered to this engine.
+         */
+        std::set<std::string> windowIds;
+
+        /**
+         * If the events of all windows are delivered to this engine.
+         */
+        bool isAllWindows;
+    };
+
+    /**
+     * A single event that is waiting to be delivered to the dart code.
+     */
+    struct PendingEvent
+    {
+        /**
+         * The ID of the window that produced the event.
+         */
+        std::string windowId;
+
+        /**
+         * The name of the event. (e.g: configure, map, focusIn, etc.)
+         */
+        std::string name;
+
+        /**
+         * The extra data of the event, this must be a map or NULL.
+         */
+        FlValue *data;
+
+        /**
+         * The ID of the window whose engine receives the event. (Empty to send to all engines)
+         */
+        std::string targetWindowId;
+    };
+
+    /**
+     * Delivers the window events (configure, map/unmap, focus, etc.) to the dart code.
+     *
+     * Every engine of the application registers an event channel on the name
+     * "fl_linux_window_manager/events". The events of a window are delivered only to the engine
+     * of that window, and to the engines that subscribed to the events of that window with
+     * subscribe(). The events that are not related to any window (e.g: monitorsChanged) are
+     * delivered to all the listening engines.
+     *
+     * The events are not sent immediately. The events emitted in a short interval are coalesced,
+     * so that only the latest event of the same name for the same window is delivered.
+     * (e.g: A burst of configure events while resizing is delivered as a single configure event)
+     */
+    class EventStream
+    {
+    public:
+        /**
+         * The name of the event channel registered in every engine.
+         */
+        static constexpr const char *channelName = "fl_linux_window_manager/events";
+
+        /**
+         * The interval in milliseconds in which the events are coalesced before delivering.
+         */
+        static constexpr unsigned int coalesceIntervalMs = 16;
+
+        /**
+         * Register the event channel in the engine of the window with the given ID.
+         */
+        static void attach(std::string windowId, FlBinaryMessenger *messenger);
+
+        /**
+         * Remove the event channel of the window with the given ID.
+         */
+        static void detach(std::string windowId);
+
+        /**
+         * Returns if there is any engine that is listening to the events.
+         */
+        static bool hasListeners();
+
+        /**
+         * Set the other windows whose events are delivered to the engine of the window with the
+         * given ID, replacing the previous subscriptions of the engine.
+         *
+         * If isAllWindows is true, the events of all windows are delivered to the engine.
+         */
+        static void subscribe(std::string windowId, std::vector<std::string> windowIds,
+                              bool isAllWindows);
+
+        /**
+         * Queue an event of the given window to be delivered to the dart code.
+         *
+         * The ownership of the data is taken by this method.
+         */
+        static void emit(std::string windowId, std::string name, FlValue *data = nullptr);
+
+        /**
+         * Queue an event of the given window to be delivered only to the engine of the target
+         * window. (e.g: The events of a window that has no engine)
+         *
+         * The ownership of the data is taken by this method.
+         */
+        static void emitTo(std::string targetWindowId, std::string windowId, std::string name,
+                           FlValue *data = nullptr);
+
+    private:
+        /**
+         * The event sinks of all engines, mapped with the ID of the window that owns the engine.
+         */
+        static std::map<std::string, EventSink> sinks;
+
+        /**
+         * The events that are waiting to be delivered, in the order of emission.
+         */
+        static std::vector<PendingEvent> pendingEvents;
+
+        /**
+         * The ID of the GSource that flushes the pending events. (0 if not scheduled)
+         */
+        static guint flushSourceId;
+
+        /**
+         * Returns if the event is delivered to the engine of the given sink.
+         */
+        static bool isDeliveredTo(const std::string &sinkWindowId, const EventSink &sink,
+                                  const std::string &targetWindowId,
+                                  const std::string &windowId);
+
+        /**
+         * Deliver all the pending events to the listening engines.
+         */
+        static gboolean flush(gpointer userData);
+
+        static FlMethodErrorResponse *onListen(FlEventChannel *channel, FlValue *args, gpointer userData);
+
+        static FlMethodErrorResponse *onCancel(FlEventChannel *channel, FlValue *args, gpointer userData);
+    };
+}
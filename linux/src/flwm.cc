@@ -3,6 +3,7 @@
 
 #include <window_manager/window_manager.h>
 #include <message_handler/message_handler.h>
+#include <event_stream/event_stream.h>
 
 /**
  * A callback that will be called when the plugin is registered with the Flutter application.
@@ -14,8 +15,19 @@ void fl_linux_window_manager_plugin_register_with_registrar(FlPluginRegistrar* r
     GtkWidget* view = GTK_WIDGET(fl_plugin_registrar_get_view(registrar));
     GtkWindow* window = GTK_WINDOW(gtk_widget_get_toplevel(view));
 
-    /// Add the window to the list of windows
-    FLWM::WindowManager::addWindow(window, "main");
+    /// Find the window that owns this engine. The windows created by the plugin are added
+    /// to the list before registering the plugins for their engines, so an unknown window
+    /// is the main window of the application.
+    std::string windowId = FLWM::WindowManager::getWindowId(window);
+    if (windowId.empty()) {
+        windowId = "main";
+
+        /// Add the window to the list of windows
+        FLWM::WindowManager::addWindow(window, windowId);
+    }
+
+    /// Register the event channel, to deliver the window events to this engine.
+    FLWM::EventStream::attach(windowId, fl_plugin_registrar_get_messenger(registrar));
 
     /// Create the method channel for the communication between the Flutter and the plugin
     g_autoptr(FlStandardMethodCodec) codec = fl_standard_method_codec_new();
@@ -25,7 +37,9 @@ void fl_linux_window_manager_plugin_register_with_registrar(FlPluginRegistrar* r
             FL_METHOD_CODEC(codec));
 
     /// Setting the callback function to execute when a method call is recieved from dart code.
-    /// 
-    /// Here we are setting the user_data for the callback as the Plugin object itself.
-    fl_method_channel_set_method_call_handler(channel, messageHandler, NULL, NULL);
+    ///
+    /// Here we are setting the user_data for the callback as the ID of the window of this engine,
+    /// so that the handler knows which window sent the method call.
+    fl_method_channel_set_method_call_handler(channel, messageHandler, g_strdup(windowId.c_str()),
+        g_free);
 }
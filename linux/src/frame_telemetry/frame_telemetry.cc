@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <iterator>
+
+#include <event_stream/event_stream.h>
+#include <frame_telemetry/frame_telemetry.h>
+#include <gdk/gdkwayland.h>
+
+/**
+ * Static member initialization
+ */
+struct wp_presentation *FLWM::FrameTelemetry::presentation = NULL;
+std::map<std::string, FLWM::WindowTelemetry> FLWM::FrameTelemetry::windows;
+guint FLWM::FrameTelemetry::reportSourceId = 0;
+
+void FLWM::FrameTelemetry::bindPresentation(struct wl_registry *registry,
+                                            uint32_t name, uint32_t version) {
+  presentation = (struct wp_presentation *)wl_registry_bind(
+      registry, name, &wp_presentation_interface, 1);
+}
+
+void FLWM::FrameTelemetry::enable(std::string windowId, GtkWindow *window) {
+  disable(windowId);
+
+  WindowTelemetry telemetry;
+  telemetry.windowId = windowId;
+  telemetry.window = window;
+  telemetry.frameClock = NULL;
+  telemetry.lastPresentedNs = 0;
+  telemetry.lastFrameCounter = 0;
+  telemetry.refreshNs = 0;
+  telemetry.presentedSinceReport = 0;
+  telemetry.stats.presented = 0;
+  telemetry.stats.discarded = 0;
+  telemetry.stats.droppedFrames = 0;
+  telemetry.stats.frameIntervals = std::vector<unsigned int>(
+      std::size(frameIntervalBucketsMs) + 1, 0);
+  telemetry.stats.maxFrameIntervalMs = 0;
+  windows[windowId] = telemetry;
+
+  /// The record in the map is used as the user data, since its address does
+  /// not change until it is removed from the map.
+  WindowTelemetry *record = &windows[windowId];
+
+  /// The window is realized again after it is hidden and shown, or moved to
+  /// another monitor, with a new frame clock.
+  g_signal_connect(window, "realize", G_CALLBACK(onRealize), record);
+  g_signal_connect(window, "unrealize", G_CALLBACK(onUnrealize), record);
+  if (gtk_widget_get_realized(GTK_WIDGET(window))) {
+    attach(record);
+  }
+
+  if (reportSourceId == 0) {
+    reportSourceId = g_timeout_add(reportIntervalMs, onReport, NULL);
+  }
+}
+
+void FLWM::FrameTelemetry::disable(std::string windowId) {
+  auto iter = windows.find(windowId);
+  if (iter == windows.end()) {
+    return;
+  }
+
+  WindowTelemetry *record = &(iter->second);
+
+  g_signal_handlers_disconnect_by_data(record->window, record);
+  detach(record);
+
+  /// The compositor may still send the events of the pending frames, so the
+  /// proxies are destroyed to stop them.
+  for (PendingFrame *frame : record->pendingFrames) {
+    wl_proxy_destroy(frame->proxy);
+    delete frame;
+  }
+
+  windows.erase(iter);
+
+  if (windows.empty() && reportSourceId != 0) {
+    g_source_remove(reportSourceId);
+    reportSourceId = 0;
+  }
+}
+
+FlValue *FLWM::FrameTelemetry::getStats(std::string windowId) {
+  auto iter = windows.find(windowId);
+  if (iter == windows.end()) {
+    FlValue *result = fl_value_new_map();
+    fl_value_set_string_take(result, "enabled", fl_value_new_bool(false));
+    return result;
+  }
+
+  return statsToValue(iter->second);
+}
+
+void FLWM::FrameTelemetry::attach(WindowTelemetry *telemetry) {
+  GdkWindow *gdkWindow = gtk_widget_get_window(GTK_WIDGET(telemetry->window));
+  GdkFrameClock *frameClock =
+      gdkWindow != NULL ? gdk_window_get_frame_clock(gdkWindow) : NULL;
+  if (frameClock == telemetry->frameClock) {
+    return;
+  }
+
+  detach(telemetry);
+  if (frameClock == NULL) {
+    return;
+  }
+
+  telemetry->frameClock = frameClock;
+  g_signal_connect(frameClock, "before-paint", G_CALLBACK(onBeforePaint),
+                   telemetry);
+}
+
+void FLWM::FrameTelemetry::detach(WindowTelemetry *telemetry) {
+  if (telemetry->frameClock == NULL) {
+    return;
+  }
+
+  g_signal_handlers_disconnect_by_data(telemetry->frameClock, telemetry);
+  telemetry->frameClock = NULL;
+
+  /// The frame counter of the next frame clock starts again, so the next frame
+  /// does not follow the last one.
+  telemetry->lastPresentedNs = 0;
+}
+
+void FLWM::FrameTelemetry::recordPresented(PendingFrame *frame,
+                                           gint64 presentedNs,
+                                           gint64 refreshNs) {
+  WindowTelemetry *telemetry = frame->owner;
+
+  /// The frames requested without a commit in between are presented together.
+  /// So only the first one is counted.
+  if (presentedNs == telemetry->lastPresentedNs) {
+    return;
+  }
+
+  if (refreshNs > 0) {
+    telemetry->refreshNs = refreshNs;
+  }
+
+  /// The interval is meaningful only between the frames drawn one after the
+  /// other. Otherwise the window was just idle in between.
+  if (telemetry->lastPresentedNs > 0 &&
+      frame->frameCounter == telemetry->lastFrameCounter + 1) {
+    double intervalMs = (presentedNs - telemetry->lastPresentedNs) / 1000000.0;
+
+    size_t bucket = 0;
+    while (bucket < std::size(frameIntervalBucketsMs) &&
+           intervalMs > frameIntervalBucketsMs[bucket]) {
+      bucket++;
+    }
+    telemetry->stats.frameIntervals[bucket]++;
+    telemetry->stats.maxFrameIntervalMs =
+        std::max(telemetry->stats.maxFrameIntervalMs, intervalMs);
+
+    if (telemetry->refreshNs > 0) {
+      gint64 cycles = (presentedNs - telemetry->lastPresentedNs +
+                       telemetry->refreshNs / 2) /
+                      telemetry->refreshNs;
+      if (cycles > 1) {
+        telemetry->stats.droppedFrames += cycles - 1;
+      }
+    }
+  }
+
+  telemetry->lastPresentedNs = presentedNs;
+  telemetry->lastFrameCounter = frame->frameCounter;
+  telemetry->stats.presented++;
+  telemetry->presentedSinceReport++;
+}
+
+void FLWM::FrameTelemetry::finishFrame(PendingFrame *frame) {
+  std::vector<PendingFrame *> &pendingFrames = frame->owner->pendingFrames;
+  pendingFrames.erase(
+      std::remove(pendingFrames.begin(), pendingFrames.end(), frame),
+      pendingFrames.end());
+
+  wl_proxy_destroy(frame->proxy);
+  delete frame;
+}
+
+void FLWM::FrameTelemetry::onRealize(GtkWidget *widget, gpointer userData) {
+  attach((WindowTelemetry *)userData);
+}
+
+void FLWM::FrameTelemetry::onUnrealize(GtkWidget *widget, gpointer userData) {
+  detach((WindowTelemetry *)userData);
+}
+
+void FLWM::FrameTelemetry::onBeforePaint(GdkFrameClock *frameClock,
+                                         gpointer userData) {
+  WindowTelemetry *telemetry = (WindowTelemetry *)userData;
+
+  if (telemetry->pendingFrames.size() >= maxPendingFrames) {
+    return;
+  }
+
+  /// The window does not have a surface while it is hidden.
+  GdkWindow *gdkWindow = gtk_widget_get_window(GTK_WIDGET(telemetry->window));
+  struct wl_surface *wlSurface =
+      gdkWindow != NULL ? gdk_wayland_window_get_wl_surface(gdkWindow) : NULL;
+  if (wlSurface == NULL) {
+    return;
+  }
+
+  PendingFrame *frame = new PendingFrame();
+  frame->owner = telemetry;
+  frame->frameCounter = gdk_frame_clock_get_frame_counter(frameClock);
+
+  /// Both requests are applied with the next commit of the surface, which is
+  /// done by GDK after painting this frame.
+  if (presentation != NULL) {
+    static const struct wp_presentation_feedback_listener feedbackListener = {
+        .sync_output = [](void *data, struct wp_presentation_feedback *feedback,
+                          struct wl_output *output) {},
+        .presented =
+            [](void *data, struct wp_presentation_feedback *feedback,
+               uint32_t tv_sec_hi, uint32_t tv_sec_lo, uint32_t tv_nsec,
+               uint32_t refresh, uint32_t seq_hi, uint32_t seq_lo,
+               uint32_t flags) {
+              PendingFrame *frame = (PendingFrame *)data;
+              gint64 seconds = ((gint64)tv_sec_hi << 32) | tv_sec_lo;
+
+              recordPresented(frame, seconds * 1000000000 + tv_nsec, refresh);
+              finishFrame(frame);
+            },
+        .discarded =
+            [](void *data, struct wp_presentation_feedback *feedback) {
+              PendingFrame *frame = (PendingFrame *)data;
+
+              frame->owner->stats.discarded++;
+              finishFrame(frame);
+            },
+    };
+
+    struct wp_presentation_feedback *feedback =
+        wp_presentation_feedback(presentation, wlSurface);
+    wp_presentation_feedback_add_listener(feedback, &feedbackListener, frame);
+    frame->proxy = (struct wl_proxy *)feedback;
+  } else {
+    static const struct wl_callback_listener callbackListener = {
+        .done =
+            [](void *data, struct wl_callback *callback, uint32_t time) {
+              PendingFrame *frame = (PendingFrame *)data;
+
+              /// The frame callback does not have the refresh duration, so the
+              /// one of the monitor is used.
+              gint64 refreshNs = 0;
+              GdkWindow *gdkWindow =
+                  gtk_widget_get_window(GTK_WIDGET(frame->owner->window));
+              GdkMonitor *monitor =
+                  gdkWindow != NULL ? gdk_display_get_monitor_at_window(
+                                          gdk_window_get_display(gdkWindow),
+                                          gdkWindow)
+                                    : NULL;
+              if (monitor != NULL && gdk_monitor_get_refresh_rate(monitor) > 0) {
+                refreshNs = 1000000000000 / gdk_monitor_get_refresh_rate(monitor);
+              }
+
+              recordPresented(frame, (gint64)time * 1000000, refreshNs);
+              finishFrame(frame);
+            },
+    };
+
+    struct wl_callback *callback = wl_surface_frame(wlSurface);
+    wl_callback_add_listener(callback, &callbackListener, frame);
+    frame->proxy = (struct wl_proxy *)callback;
+  }
+
+  telemetry->pendingFrames.push_back(frame);
+}
+
+gboolean FLWM::FrameTelemetry::onReport(gpointer userData) {
+  for (auto &[id, telemetry] : windows) {
+    if (telemetry.presentedSinceReport == 0) {
+      continue;
+    }
+    telemetry.presentedSinceReport = 0;
+
+    FLWM::EventStream::emit(id, "frameStats", statsToValue(telemetry));
+  }
+
+  return G_SOURCE_CONTINUE;
+}
+
+FlValue *FLWM::FrameTelemetry::statsToValue(const WindowTelemetry &telemetry) {
+  FlValue *bounds = fl_value_new_list();
+  for (unsigned int bound : frameIntervalBucketsMs) {
+    fl_value_append_take(bounds, fl_value_new_int(bound));
+  }
+
+  FlValue *counts = fl_value_new_list();
+  for (unsigned int count : telemetry.stats.frameIntervals) {
+    fl_value_append_take(counts, fl_value_new_int(count));
+  }
+
+  FlValue *result = fl_value_new_map();
+  fl_value_set_string_take(result, "enabled", fl_value_new_bool(true));
+  fl_value_set_string_take(
+      result, "source",
+      fl_value_new_string(presentation != NULL ? "presentation"
+                                               : "frameCallback"));
+  fl_value_set_string_take(result, "presented",
+                           fl_value_new_int(telemetry.stats.presented));
+  fl_value_set_string_take(result, "discarded",
+                           fl_value_new_int(telemetry.stats.discarded));
+  fl_value_set_string_take(result, "droppedFrames",
+                           fl_value_new_int(telemetry.stats.droppedFrames));
+  fl_value_set_string_take(
+      result, "maxFrameIntervalMs",
+      fl_value_new_float(telemetry.stats.maxFrameIntervalMs));
+  fl_value_set_string_take(
+      result, "refreshRate",
+      fl_value_new_float(telemetry.refreshNs > 0
+                             ? 1000000000.0 / telemetry.refreshNs
+                             : 0));
+  fl_value_set_string_take(result, "frameIntervalBoundsMs", bounds);
+  fl_value_set_string_take(result, "frameIntervals", counts);
+  return result;
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <gtk/gtk.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <flutter_linux/flutter_linux.h>
+#include <protocol_bindings/presentation_time_protocol_client.h>
+#include <wayland-client.h>
+
+namespace FLWM
+{
+    struct WindowTelemetry;
+
+    /**
+     * A frame of a window whose presentation is not reported by the compositor yet.
+     */
+    struct PendingFrame
+    {
+        WindowTelemetry *owner;
+
+        /**
+         * The wp_presentation_feedback or wl_callback object that reports the presentation.
+         */
+        struct wl_proxy *proxy;
+
+        /**
+         * The frame counter of the frame clock, for the frame in which the proxy is requested.
+         */
+        gint64 frameCounter;
+    };
+
+    /**
+     * The frame timing statistics of a window.
+     */
+    struct FrameStats
+    {
+        /**
+         * The number of frames that are presented on the screen.
+         */
+        unsigned int presented;
+
+        /**
+         * The number of frames that are superseded by another frame before being presented.
+         */
+        unsigned int discarded;
+
+        /**
+         * The number of refresh cycles missed between the consecutive frames.
+         */
+        unsigned int droppedFrames;
+
+        /**
+         * The number of frame intervals in each bucket of frameIntervalBucketsMs.
+         */
+        std::vector<unsigned int> frameIntervals;
+
+        /**
+         * The longest interval between two consecutive frames, in milliseconds.
+         */
+        double maxFrameIntervalMs;
+    };
+
+    /**
+     * The frame timing collection state of a window.
+     */
+    struct WindowTelemetry
+    {
+        std::string windowId;
+
+        GtkWindow *window;
+
+        /**
+         * The frame clock of the window. (NULL while the window is not realized)
+         */
+        GdkFrameClock *frameClock;
+
+        /**
+         * The frames requested for the presentation timing, in the request order.
+         */
+        std::vector<PendingFrame *> pendingFrames;
+
+        /**
+         * The presentation time of the last presented frame in nanoseconds.
+         */
+        gint64 lastPresentedNs;
+
+        /**
+         * The frame counter of the last presented frame.
+         */
+        gint64 lastFrameCounter;
+
+        /**
+         * The refresh duration of the output in nanoseconds. (0 if not known)
+         */
+        gint64 refreshNs;
+
+        /**
+         * The number of frames presented after the last report.
+         */
+        unsigned int presentedSinceReport;
+
+        FrameStats stats;
+    };
+
+    /**
+     * Collects the frame timing of the windows, using the wp_presentation feedback if the
+     * compositor supports it, and the wl_surface frame callbacks otherwise.
+     *
+     * The collection is disabled by default, and enabled for each window. The statistics of the
+     * enabled windows are delivered to the dart code as "frameStats" events periodically.
+     */
+    class FrameTelemetry
+    {
+    public:
+        /**
+         * The upper bounds of the frame interval histogram buckets in milliseconds. The intervals
+         * longer than the last bound are counted in an extra bucket.
+         */
+        static constexpr unsigned int frameIntervalBucketsMs[] = {8, 17, 25, 34, 50, 100};
+
+        /**
+         * The interval of the "frameStats" events in milliseconds.
+         */
+        static constexpr unsigned int reportIntervalMs = 1000;
+
+        /**
+         * The maximum number of frames waiting for the presentation of a window. The frames
+         * requested while the compositor is not presenting the window are not tracked.
+         */
+        static constexpr size_t maxPendingFrames = 4;
+
+        /**
+         * Bind the wp_presentation global advertised by the compositor.
+         */
+        static void bindPresentation(struct wl_registry *registry, uint32_t name, uint32_t version);
+
+        /**
+         * Start collecting the frame timing of the given window. The statistics are reset.
+         */
+        static void enable(std::string windowId, GtkWindow *window);
+
+        /**
+         * Stop collecting the frame timing of the given window.
+         */
+        static void disable(std::string windowId);
+
+        /**
+         * Returns the frame timing statistics of the given window as a map.
+         * The returned value is a new reference.
+         */
+        static FlValue *getStats(std::string windowId);
+
+    private:
+        static struct wp_presentation *presentation;
+
+        /**
+         * The windows whose frame timing is collected, mapped with the window IDs.
+         */
+        static std::map<std::string, WindowTelemetry> windows;
+
+        /**
+         * The ID of the GSource that reports the statistics. (0 if not scheduled)
+         */
+        static guint reportSourceId;
+
+        /**
+         * Start listening to the frame clock of the window. The frame clock belongs to the GDK
+         * window, so it is attached again every time the window is realized.
+         */
+        static void attach(WindowTelemetry *telemetry);
+
+        /**
+         * Stop listening to the frame clock of the window.
+         */
+        static void detach(WindowTelemetry *telemetry);
+
+        /**
+         * Record a frame that is presented at the given time.
+         */
+        static void recordPresented(PendingFrame *frame, gint64 presentedNs, gint64 refreshNs);
+
+        /**
+         * Remove the given frame from the pending frames of its window and free it.
+         */
+        static void finishFrame(PendingFrame *frame);
+
+        static void onRealize(GtkWidget *widget, gpointer userData);
+
+        static void onUnrealize(GtkWidget *widget, gpointer userData);
+
+        static void onBeforePaint(GdkFrameClock *frameClock, gpointer userData);
+
+        static gboolean onReport(gpointer userData);
+
+        /**
+         * Create the statistics map of the given window.
+         */
+        static FlValue *statsToValue(const WindowTelemetry &telemetry);
+    };
+}
@@ -0,0 +1,33 @@
+#include <handles/handles.h>
+
+std::map<std::string, long, std::less<>> &FLWM::HandleCounter::getCountMap() {
+  static auto *counts = new std::map<std::string, long, std::less<>>();
+  return *counts;
+}
+
+void FLWM::HandleCounter::add(const char *typeName) {
+  auto &counts = getCountMap();
+  auto iter = counts.find(typeName);
+  if (iter == counts.end()) {
+    counts[typeName] = 1;
+  } else {
+    iter->second++;
+  }
+}
+
+void FLWM::HandleCounter::remove(const char *typeName) {
+  auto &counts = getCountMap();
+  auto iter = counts.find(typeName);
+  if (iter != counts.end()) {
+    iter->second--;
+  }
+}
+
+FlValue *FLWM::HandleCounter::getCounts() {
+  FlValue *result = fl_value_new_map();
+  for (auto const &[typeName, count] : getCountMap()) {
+    fl_value_set_string_take(result, typeName.c_str(), fl_value_new_int(count));
+  }
+
+  return result;
+}
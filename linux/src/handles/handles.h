@@ -0,0 +1,298 @@
+#pragma once
+
+#include <gtk/gtk.h>
+#include <map>
+#include <string>
+#include <utility>
+
+#include <flutter_linux/flutter_linux.h>
+#include <wayland-client.h>
+
+namespace FLWM
+{
+    /**
+     * Counts the live objects owned by the handles of the plugin, per type name.
+     * This is used to check that the plugin does not leak objects in long running processes.
+     */
+    class HandleCounter
+    {
+    public:
+        static void add(const char *typeName);
+
+        static void remove(const char *typeName);
+
+        /**
+         * Returns a map of the type names to the number of live objects of that type.
+         * The returned value is a new reference.
+         */
+        static FlValue *getCounts();
+
+    private:
+        /**
+         * Returns the counts, mapped with the type names.
+         *
+         * The map is created on the first use and never destroyed, because the handles held by the
+         * static members of other files (e.g: The event sinks) are released after the static
+         * members of this file are destroyed at exit.
+         */
+        static std::map<std::string, long, std::less<>> &getCountMap();
+    };
+
+    /**
+     * Owns a reference of a GObject, and releases it when the handle is destroyed.
+     *
+     * The handle converts to the object pointer implicitly, so it can be passed to the C APIs
+     * directly. A handle returned from a function is released at the end of the expression.
+     * (e.g: fl_method_call_respond(methodCall, successResponse(), NULL))
+     */
+    template <typename T>
+    class GObjectRef
+    {
+    public:
+        GObjectRef() : object(nullptr), typeName(nullptr) {}
+
+        /**
+         * Take the ownership of the given reference. (e.g: The result of a *_new() function)
+         */
+        explicit GObjectRef(T *object) : object(nullptr), typeName(nullptr) { reset(object); }
+
+        GObjectRef(GObjectRef &&other) noexcept
+            : object(std::exchange(other.object, nullptr)), typeName(other.typeName) {}
+
+        GObjectRef &operator=(GObjectRef &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                object = std::exchange(other.object, nullptr);
+                typeName = other.typeName;
+            }
+            return *this;
+        }
+
+        GObjectRef(const GObjectRef &) = delete;
+
+        GObjectRef &operator=(const GObjectRef &) = delete;
+
+        ~GObjectRef() { reset(); }
+
+        /**
+         * Create a handle with a new reference of the given object, without taking the
+         * ownership of the caller's reference.
+         */
+        static GObjectRef ref(T *object)
+        {
+            return GObjectRef(object != nullptr ? (T *)g_object_ref(object) : nullptr);
+        }
+
+        /**
+         * Release the current object and take the ownership of the given reference.
+         */
+        void reset(T *newObject = nullptr)
+        {
+            if (object != nullptr)
+            {
+                HandleCounter::remove(typeName);
+                g_object_unref(object);
+            }
+
+            object = newObject;
+            if (object != nullptr)
+            {
+                typeName = G_OBJECT_TYPE_NAME(object);
+                HandleCounter::add(typeName);
+            }
+        }
+
+        T *get() const { return object; }
+
+        operator T *() const { return object; }
+
+    private:
+        T *object;
+
+        /**
+         * The GType name of the object. This is a static string owned by the type system.
+         */
+        const char *typeName;
+    };
+
+    /**
+     * Owns a reference of a FlValue, and releases it when the handle is destroyed.
+     */
+    class FlValueRef
+    {
+    public:
+        FlValueRef() : value(nullptr) {}
+
+        /**
+         * Take the ownership of the given reference. (e.g: The result of a fl_value_new_*())
+         */
+        explicit FlValueRef(FlValue *value) : value(nullptr) { reset(value); }
+
+        FlValueRef(FlValueRef &&other) noexcept : value(std::exchange(other.value, nullptr)) {}
+
+        FlValueRef &operator=(FlValueRef &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                value = std::exchange(other.value, nullptr);
+            }
+            return *this;
+        }
+
+        FlValueRef(const FlValueRef &) = delete;
+
+        FlValueRef &operator=(const FlValueRef &) = delete;
+
+        ~FlValueRef() { reset(); }
+
+        void reset(FlValue *newValue = nullptr)
+        {
+            if (value != nullptr)
+            {
+                HandleCounter::remove("FlValue");
+                fl_value_unref(value);
+            }
+
+            value = newValue;
+            if (value != nullptr)
+            {
+                HandleCounter::add("FlValue");
+            }
+        }
+
+        FlValue *get() const { return value; }
+
+        operator FlValue *() const { return value; }
+
+    private:
+        FlValue *value;
+    };
+
+    /**
+     * Owns a cairo region, and destroys it when the handle is destroyed.
+     */
+    class CairoRegionRef
+    {
+    public:
+        CairoRegionRef() : region(nullptr) {}
+
+        /**
+         * Take the ownership of the given region. (e.g: The result of cairo_region_create())
+         */
+        explicit CairoRegionRef(cairo_region_t *region) : region(nullptr) { reset(region); }
+
+        CairoRegionRef(CairoRegionRef &&other) noexcept
+            : region(std::exchange(other.region, nullptr)) {}
+
+        CairoRegionRef &operator=(CairoRegionRef &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                region = std::exchange(other.region, nullptr);
+            }
+            return *this;
+        }
+
+        CairoRegionRef(const CairoRegionRef &) = delete;
+
+        CairoRegionRef &operator=(const CairoRegionRef &) = delete;
+
+        ~CairoRegionRef() { reset(); }
+
+        void reset(cairo_region_t *newRegion = nullptr)
+        {
+            if (region != nullptr)
+            {
+                HandleCounter::remove("cairo_region_t");
+                cairo_region_destroy(region);
+            }
+
+            region = newRegion;
+            if (region != nullptr)
+            {
+                HandleCounter::add("cairo_region_t");
+            }
+        }
+
+        cairo_region_t *get() const { return region; }
+
+        operator cairo_region_t *() const { return region; }
+
+    private:
+        cairo_region_t *region;
+    };
+
+    /**
+     * Owns a wayland proxy, and sends the destructor request with the given opcode when the
+     * handle is destroyed. (e.g: WlProxy<wl_region, WL_REGION_DESTROY>)
+     *
+     * The opcode is used instead of the generated *_destroy() functions, because they are static
+     * and would give the structs holding a handle an internal linkage.
+     */
+    template <typename T, uint32_t DestroyOpcode>
+    class WlProxy
+    {
+    public:
+        WlProxy() : proxy(nullptr), typeName(nullptr) {}
+
+        /**
+         * Take the ownership of the given proxy.
+         */
+        explicit WlProxy(T *proxy) : proxy(nullptr), typeName(nullptr) { reset(proxy); }
+
+        WlProxy(WlProxy &&other) noexcept
+            : proxy(std::exchange(other.proxy, nullptr)), typeName(other.typeName) {}
+
+        WlProxy &operator=(WlProxy &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                proxy = std::exchange(other.proxy, nullptr);
+                typeName = other.typeName;
+            }
+            return *this;
+        }
+
+        WlProxy(const WlProxy &) = delete;
+
+        WlProxy &operator=(const WlProxy &) = delete;
+
+        ~WlProxy() { reset(); }
+
+        /**
+         * Destroy the current proxy and take the ownership of the given proxy.
+         */
+        void reset(T *newProxy = nullptr)
+        {
+            if (proxy != nullptr)
+            {
+                HandleCounter::remove(typeName);
+                wl_proxy_marshal_flags((struct wl_proxy *)proxy, DestroyOpcode, NULL,
+                                       wl_proxy_get_version((struct wl_proxy *)proxy),
+                                       WL_MARSHAL_FLAG_DESTROY);
+            }
+
+            proxy = newProxy;
+            if (proxy != nullptr)
+            {
+                /// The class of a proxy is the name of its interface, which is a static string.
+                typeName = wl_proxy_get_class((struct wl_proxy *)proxy);
+                HandleCounter::add(typeName);
+            }
+        }
+
+        T *get() const { return proxy; }
+
+        operator T *() const { return proxy; }
+
+    private:
+        T *proxy;
+
+        const char *typeName;
+    };
+}
@@ -0,0 +1,243 @@
+#include <input_mask/input_mask.h>
+#include <logger/logger.h>
+
+/// FLWM_INPUT_MASK_SCALAR disables the vector code, so that the tests can
+/// check the scalar code on any machine.
+#if !defined(FLWM_INPUT_MASK_SCALAR) && defined(__SSE2__)
+#define FLWM_INPUT_MASK_SSE2
+#include <emmintrin.h>
+#elif !defined(FLWM_INPUT_MASK_SCALAR) && defined(__ARM_NEON) &&              \
+    defined(__aarch64__)
+#define FLWM_INPUT_MASK_NEON
+#include <arm_neon.h>
+#endif
+
+/**
+ * The number of pixels loaded at a time.
+ */
+static constexpr int _blockSize = 16;
+
+/**
+ * Add the runs in the bits of count pixels starting from x. The run that is
+ * not ended in these pixels is kept in runStart. (-1 if there is no such run)
+ */
+static void _addRuns(uint32_t bits, int count, int x, int &runStart,
+                     std::vector<int> &edges) {
+  uint32_t all = (1u << count) - 1;
+
+  /// Most of the blocks of a real mask are inside or outside of a shape, and
+  /// do not change the current run.
+  if (runStart >= 0 ? bits == all : bits == 0) {
+    return;
+  }
+
+  int i = 0;
+  while (i < count) {
+    if (runStart >= 0) {
+      uint32_t clear = ~bits & all & (~0u << i);
+      if (clear == 0) {
+        return;
+      }
+
+      i = __builtin_ctz(clear);
+      edges.push_back(runStart);
+      edges.push_back(x + i);
+      runStart = -1;
+    } else {
+      uint32_t set = bits & (~0u << i);
+      if (set == 0) {
+        return;
+      }
+
+      i = __builtin_ctz(set);
+      runStart = x + i;
+    }
+  }
+}
+
+size_t FLWM::InputMask::getRowLength(int width, MaskFormat format) {
+  switch (format) {
+  case MASK_FORMAT_RGBA8:
+    return (size_t)width * 4;
+  case MASK_FORMAT_BITS:
+    return ((size_t)width + 7) / 8;
+  default:
+    return (size_t)width;
+  }
+}
+
+bool FLWM::InputMask::toRects(const Mask &mask, std::vector<MaskRect> &rects) {
+  rects.clear();
+
+  if (mask.width <= 0 || mask.height <= 0) {
+    return true;
+  }
+
+  size_t rowLength = getRowLength(mask.width, mask.format);
+  if (mask.data == NULL || mask.length < rowLength * mask.height) {
+    FLWM_LOG_WARNING("The mask has %zu bytes, but a %dx%d mask needs %zu bytes",
+                     mask.length, mask.width, mask.height,
+                     rowLength * mask.height);
+    return false;
+  }
+
+  /// No alpha is greater than the maximum.
+  if (mask.format != MASK_FORMAT_BITS && mask.threshold == UINT8_MAX) {
+    return true;
+  }
+
+  scan(mask, false, rects);
+
+  if (rects.size() > maxRects) {
+    FLWM_LOG_DEBUG("The mask has %zu rects, using a rect for each band",
+                   rects.size());
+    rects.clear();
+    scan(mask, true, rects);
+  }
+
+  return true;
+}
+
+uint32_t FLWM::InputMask::loadBlock(const Mask &mask, const uint8_t *row,
+                                    int x) {
+  if (mask.format == MASK_FORMAT_BITS) {
+    /// The block starts at a byte, since x is a multiple of the block size.
+    const uint8_t *bytes = row + x / 8;
+    return bytes[0] | (bytes[1] << 8);
+  }
+
+#if defined(FLWM_INPUT_MASK_SSE2)
+  __m128i alpha;
+  if (mask.format == MASK_FORMAT_RGBA8) {
+    /// Move the alpha of each pixel into the low byte of the pixel, and pack
+    /// the alpha of the 16 pixels into a vector of bytes. (The alpha is at
+    /// most 255, so the packs do not saturate)
+    const __m128i *pixels = (const __m128i *)(row + x * 4);
+    __m128i a0 = _mm_srli_epi32(_mm_loadu_si128(pixels), 24);
+    __m128i a1 = _mm_srli_epi32(_mm_loadu_si128(pixels + 1), 24);
+    __m128i a2 = _mm_srli_epi32(_mm_loadu_si128(pixels + 2), 24);
+    __m128i a3 = _mm_srli_epi32(_mm_loadu_si128(pixels + 3), 24);
+    alpha = _mm_packus_epi16(_mm_packs_epi32(a0, a1), _mm_packs_epi32(a2, a3));
+  } else {
+    alpha = _mm_loadu_si128((const __m128i *)(row + x));
+  }
+
+  /// SSE2 has no unsigned compare of bytes, so alpha > threshold is checked
+  /// as max(alpha, threshold + 1) == alpha.
+  __m128i minimum = _mm_set1_epi8((char)(mask.threshold + 1));
+  __m128i isSet = _mm_cmpeq_epi8(_mm_max_epu8(alpha, minimum), alpha);
+  return (uint32_t)_mm_movemask_epi8(isSet);
+#elif defined(FLWM_INPUT_MASK_NEON)
+  uint8x16_t alpha;
+  if (mask.format == MASK_FORMAT_RGBA8) {
+    /// The load de-interleaves the channels, so the fourth vector has the
+    /// alpha of the 16 pixels.
+    alpha = vld4q_u8(row + x * 4).val[3];
+  } else {
+    alpha = vld1q_u8(row + x);
+  }
+
+  /// NEON has no move mask, so each byte of the compare result keeps the bit
+  /// of its pixel, and the bits of each half are added into a byte.
+  static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                      1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t isSet = vcgtq_u8(alpha, vdupq_n_u8(mask.threshold));
+  uint8x16_t bits = vandq_u8(isSet, vld1q_u8(weights));
+  return vaddv_u8(vget_low_u8(bits)) | (vaddv_u8(vget_high_u8(bits)) << 8);
+#else
+  return loadTail(mask, row, x, _blockSize);
+#endif
+}
+
+uint32_t FLWM::InputMask::loadTail(const Mask &mask, const uint8_t *row, int x,
+                                   int count) {
+  uint32_t bits = 0;
+  for (int i = 0; i < count; i++) {
+    int pixel = x + i;
+    bool isSet;
+    switch (mask.format) {
+    case MASK_FORMAT_RGBA8:
+      isSet = row[pixel * 4 + 3] > mask.threshold;
+      break;
+    case MASK_FORMAT_BITS:
+      isSet = (row[pixel / 8] >> (pixel % 8)) & 1;
+      break;
+    default:
+      isSet = row[pixel] > mask.threshold;
+      break;
+    }
+
+    bits |= (uint32_t)isSet << i;
+  }
+
+  return bits;
+}
+
+void FLWM::InputMask::scanRow(const Mask &mask, const uint8_t *row,
+                              std::vector<Run> &runs) {
+  /// The edges are collected as pairs of start and end.
+  static thread_local std::vector<int> edges;
+  edges.clear();
+
+  int runStart = -1;
+  int x = 0;
+  for (; x + _blockSize <= mask.width; x += _blockSize) {
+    _addRuns(loadBlock(mask, row, x), _blockSize, x, runStart, edges);
+  }
+
+  if (x < mask.width) {
+    int count = mask.width - x;
+    _addRuns(loadTail(mask, row, x, count), count, x, runStart, edges);
+  }
+
+  if (runStart >= 0) {
+    edges.push_back(runStart);
+    edges.push_back(mask.width);
+  }
+
+  runs.clear();
+  for (size_t i = 0; i < edges.size(); i += 2) {
+    runs.push_back({edges[i], edges[i + 1]});
+  }
+}
+
+void FLWM::InputMask::addBand(const std::vector<Run> &runs, int y, int height,
+                              bool coarse, std::vector<MaskRect> &rects) {
+  if (runs.empty()) {
+    return;
+  }
+
+  if (coarse) {
+    rects.push_back(
+        {runs.front().start, y, runs.back().end - runs.front().start, height});
+    return;
+  }
+
+  for (const Run &run : runs) {
+    rects.push_back({run.start, y, run.end - run.start, height});
+  }
+}
+
+void FLWM::InputMask::scan(const Mask &mask, bool coarse,
+                           std::vector<MaskRect> &rects) {
+  size_t rowLength = getRowLength(mask.width, mask.format);
+
+  std::vector<Run> band;
+  std::vector<Run> runs;
+  int bandStart = 0;
+
+  for (int y = 0; y < mask.height; y++) {
+    scanRow(mask, mask.data + rowLength * y, runs);
+
+    /// The band continues while the rows have the same runs.
+    if (y > 0 && runs == band) {
+      continue;
+    }
+
+    addBand(band, bandStart, y - bandStart, coarse, rects);
+    band.swap(runs);
+    bandStart = y;
+  }
+
+  addBand(band, bandStart, mask.height - bandStart, coarse, rects);
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace FLWM
+{
+    enum __attribute__((visibility("default"))) MaskFormat
+    {
+        /**
+         * One byte of alpha per pixel.
+         */
+        MASK_FORMAT_ALPHA8 = 0,
+
+        /**
+         * Four bytes per pixel in the R, G, B, A order. (i.e: ui.ImageByteFormat.rawRgba)
+         */
+        MASK_FORMAT_RGBA8,
+
+        /**
+         * One bit per pixel, the first pixel of a byte in the least significant bit. Each row
+         * starts at a new byte.
+         */
+        MASK_FORMAT_BITS
+    };
+
+    /**
+     * A mask of the pixels that take the input.
+     */
+    struct Mask
+    {
+        const uint8_t *data;
+
+        /**
+         * The length of the data in bytes.
+         */
+        size_t length;
+
+        int width;
+
+        int height;
+
+        MaskFormat format;
+
+        /**
+         * A pixel is set if its alpha is greater than the threshold. (Not used by MASK_FORMAT_BITS)
+         */
+        uint8_t threshold;
+    };
+
+    struct MaskRect
+    {
+        int x;
+
+        int y;
+
+        int width;
+
+        int height;
+
+        bool operator==(const MaskRect &other) const
+        {
+            return x == other.x && y == other.y && width == other.width && height == other.height;
+        }
+    };
+
+    /**
+     * Converts a mask into the rects of a region.
+     *
+     * The rows are scanned 16 pixels at a time with SSE2 or NEON (where available), so that
+     * the blocks that are fully set or fully clear are skipped with a single compare. The runs of
+     * set pixels in a row are the rects of the row, and the consecutive rows with the same runs
+     * are merged into a band. This is the same banded form that the compositors store the
+     * regions in.
+     */
+    class InputMask
+    {
+    public:
+        /**
+         * The maximum number of rects of a region. Each rect is a request to the compositor, so
+         * a noisy mask is simplified into a single rect per band if it has more rects than this.
+         */
+        static constexpr size_t maxRects = 4096;
+
+        /**
+         * Returns the number of bytes of a row of the mask.
+         */
+        static size_t getRowLength(int width, MaskFormat format);
+
+        /**
+         * Convert the mask into the rects of its set pixels.
+         *
+         * Returns false if the data is smaller than the size of the mask.
+         */
+        static bool toRects(const Mask &mask, std::vector<MaskRect> &rects);
+
+    private:
+        /**
+         * A run of set pixels in a row. (The end is exclusive)
+         */
+        struct Run
+        {
+            int start;
+
+            int end;
+
+            bool operator==(const Run &other) const
+            {
+                return start == other.start && end == other.end;
+            }
+        };
+
+        /**
+         * Returns a bit for each of the 16 pixels starting from x, set if the pixel is set.
+         */
+        static uint32_t loadBlock(const Mask &mask, const uint8_t *row, int x);
+
+        /**
+         * Returns a bit for each of the count pixels starting from x. (Used for the pixels after
+         * the last full block of a row)
+         */
+        static uint32_t loadTail(const Mask &mask, const uint8_t *row, int x, int count);
+
+        /**
+         * Find the runs of set pixels in the row.
+         */
+        static void scanRow(const Mask &mask, const uint8_t *row, std::vector<Run> &runs);
+
+        /**
+         * Add the rects of a band to the list. If coarse, a single rect that bounds the runs is
+         * added.
+         */
+        static void addBand(const std::vector<Run> &runs, int y, int height, bool coarse,
+                            std::vector<MaskRect> &rects);
+
+        static void scan(const Mask &mask, bool coarse, std::vector<MaskRect> &rects);
+    };
+}
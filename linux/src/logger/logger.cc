@@ -0,0 +1,233 @@
+#include <chrono>
+#include <mutex>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <string.h>
+
+#include <logger/logger.h>
+
+/**
+ * Read the initial log level from the FLWM_LOG_LEVEL environment variable.
+ */
+int _getInitialLevel() {
+  const char *value = getenv("FLWM_LOG_LEVEL");
+  if (value == NULL) {
+    return FLWM::LOG_LEVEL_INFO;
+  }
+
+  if (g_ascii_strcasecmp(value, "debug") == 0) {
+    return FLWM::LOG_LEVEL_DEBUG;
+  } else if (g_ascii_strcasecmp(value, "warning") == 0) {
+    return FLWM::LOG_LEVEL_WARNING;
+  } else if (g_ascii_strcasecmp(value, "error") == 0) {
+    return FLWM::LOG_LEVEL_ERROR;
+  } else if (g_ascii_strcasecmp(value, "none") == 0) {
+    return FLWM::LOG_LEVEL_NONE;
+  }
+
+  return FLWM::LOG_LEVEL_INFO;
+}
+
+const char *_getLevelName(FLWM::LogLevel level) {
+  switch (level) {
+  case FLWM::LOG_LEVEL_DEBUG:
+    return "DEBUG";
+  case FLWM::LOG_LEVEL_INFO:
+    return "INFO";
+  case FLWM::LOG_LEVEL_WARNING:
+    return "WARNING";
+  case FLWM::LOG_LEVEL_ERROR:
+    return "ERROR";
+  default:
+    return "";
+  }
+}
+
+/**
+ * Static member initialization
+ */
+std::atomic<int> FLWM::Logger::level{_getInitialLevel()};
+FLWM::LogSlot FLWM::Logger::slots[bufferSize];
+std::atomic<size_t> FLWM::Logger::writePosition{0};
+size_t FLWM::Logger::readPosition = 0;
+std::atomic<unsigned int> FLWM::Logger::droppedCount{0};
+std::atomic<bool> FLWM::Logger::isRunning{false};
+std::thread FLWM::Logger::thread;
+std::atomic<bool> FLWM::Logger::isWakeRequested{false};
+std::mutex FLWM::Logger::wakeMutex;
+std::condition_variable FLWM::Logger::wakeCondition;
+
+void FLWM::Logger::setLevel(LogLevel level) {
+  Logger::level.store(level, std::memory_order_relaxed);
+}
+
+bool FLWM::Logger::isEnabled(LogLevel level) {
+  return level >= Logger::level.load(std::memory_order_relaxed);
+}
+
+void FLWM::Logger::log(LogLevel level, LogSite *site, const char *format,
+                       ...) {
+  static std::once_flag startFlag;
+  std::call_once(startFlag, start);
+
+  /// Start a new rate limiting window if the current one is over, and take the
+  /// number of messages suppressed in the previous one.
+  gint64 now = g_get_monotonic_time();
+  unsigned int suppressed = 0;
+  if (now - site->windowStart.load(std::memory_order_relaxed) >=
+      (gint64)rateLimitWindowMs * 1000) {
+    site->windowStart.store(now, std::memory_order_relaxed);
+    site->count.store(0, std::memory_order_relaxed);
+    suppressed = site->suppressed.exchange(0, std::memory_order_relaxed);
+  }
+
+  if (site->count.fetch_add(1, std::memory_order_relaxed) >= rateLimitBurst) {
+    site->suppressed.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  size_t position;
+  LogSlot *slot = claimSlot(&position);
+  if (slot == NULL) {
+    droppedCount.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  /// The message is formatted directly into the slot, so nothing is allocated.
+  slot->level = level;
+
+  va_list args;
+  va_start(args, format);
+  g_vsnprintf(slot->message, sizeof(slot->message), format, args);
+  va_end(args);
+
+  if (suppressed > 0) {
+    size_t length = strlen(slot->message);
+    g_snprintf(slot->message + length, sizeof(slot->message) - length,
+               " (%u similar messages suppressed)", suppressed);
+  }
+
+  /// Publish the slot to the background thread.
+  slot->sequence.store(position + 1, std::memory_order_release);
+  wake();
+}
+
+FLWM::LogSlot *FLWM::Logger::claimSlot(size_t *position) {
+  size_t current = writePosition.load(std::memory_order_relaxed);
+
+  while (true) {
+    LogSlot *slot = &slots[current & (bufferSize - 1)];
+    size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    intptr_t difference = (intptr_t)sequence - (intptr_t)current;
+
+    if (difference == 0) {
+      /// The slot is free. Take it, unless another thread took it first.
+      if (writePosition.compare_exchange_weak(current, current + 1,
+                                              std::memory_order_relaxed)) {
+        *position = current;
+        return slot;
+      }
+    } else if (difference < 0) {
+      /// The slot is not read yet, so the buffer is full.
+      return NULL;
+    } else {
+      current = writePosition.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void FLWM::Logger::start() {
+  for (size_t i = 0; i < bufferSize; i++) {
+    slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  isRunning.store(true);
+  thread = std::thread(run);
+
+  atexit(stop);
+}
+
+void FLWM::Logger::stop() {
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    isRunning.store(false);
+  }
+  wakeCondition.notify_one();
+
+  if (thread.joinable()) {
+    thread.join();
+  }
+
+  flush();
+}
+
+void FLWM::Logger::run() {
+  std::unique_lock<std::mutex> lock(wakeMutex);
+
+  while (isRunning.load()) {
+    /// Sleep until a message is logged, so the thread does not wake up while
+    /// nothing is logged.
+    wakeCondition.wait(
+        lock, [] { return isWakeRequested.load() || !isRunning.load(); });
+
+    /// Wait for the other messages logged with the first one, unless stopped.
+    wakeCondition.wait_for(lock, std::chrono::milliseconds(flushIntervalMs),
+                           [] { return !isRunning.load(); });
+
+    /// The request is cleared before flushing, so a message published after
+    /// the flush has passed its slot wakes the thread again.
+    isWakeRequested.exchange(false);
+
+    lock.unlock();
+    flush();
+    lock.lock();
+  }
+}
+
+void FLWM::Logger::wake() {
+  if (isWakeRequested.exchange(true)) {
+    return;
+  }
+
+  /// Take the mutex, so that the background thread is either waiting or checks
+  /// the request after it is set. Otherwise the notification may be lost.
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex);
+  }
+  wakeCondition.notify_one();
+}
+
+void FLWM::Logger::flush() {
+  std::string output;
+
+  while (true) {
+    LogSlot *slot = &slots[readPosition & (bufferSize - 1)];
+    if (slot->sequence.load(std::memory_order_acquire) != readPosition + 1) {
+      break;
+    }
+
+    output += "fl_linux_window_manager [";
+    output += _getLevelName(slot->level);
+    output += "] ";
+    output += slot->message;
+    output += "\n";
+
+    /// Release the slot for the next round of the writers.
+    slot->sequence.store(readPosition + bufferSize, std::memory_order_release);
+    readPosition++;
+  }
+
+  unsigned int dropped = droppedCount.exchange(0, std::memory_order_relaxed);
+  if (dropped > 0) {
+    output += "fl_linux_window_manager [WARNING] " + std::to_string(dropped) +
+              " messages dropped, the log buffer was full\n";
+  }
+
+  /// Write all messages with a single write, instead of one per message.
+  if (!output.empty()) {
+    fwrite(output.data(), 1, output.size(), stderr);
+    fflush(stderr);
+  }
+}
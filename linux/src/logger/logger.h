@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <glib.h>
+#include <mutex>
+#include <thread>
+
+namespace FLWM
+{
+    enum LogLevel
+    {
+        LOG_LEVEL_DEBUG,
+        LOG_LEVEL_INFO,
+        LOG_LEVEL_WARNING,
+        LOG_LEVEL_ERROR,
+        LOG_LEVEL_NONE
+    };
+
+    /**
+     * The rate limiting state of a place in the code that writes logs.
+     * Each FLWM_LOG_* macro has its own static instance.
+     */
+    struct LogSite
+    {
+        /**
+         * The start of the current rate limiting window, in the monotonic time.
+         */
+        std::atomic<gint64> windowStart{0};
+
+        /**
+         * The number of messages written in the current window.
+         */
+        std::atomic<unsigned int> count{0};
+
+        /**
+         * The number of messages dropped in the current window.
+         */
+        std::atomic<unsigned int> suppressed{0};
+    };
+
+    /**
+     * A slot of the log ring buffer.
+     */
+    struct LogSlot
+    {
+        /**
+         * The sequence number used to synchronize the writers and the reader of the slot.
+         */
+        std::atomic<size_t> sequence;
+
+        LogLevel level;
+
+        char message[256];
+    };
+
+    /**
+     * Writes the logs of the plugin to stderr.
+     *
+     * The messages are formatted into a lock-free ring buffer by the calling thread, and written
+     * in batches by a background thread. So the main loop never blocks on stderr. (e.g: stderr is
+     * a pipe to journald)
+     *
+     * Use the FLWM_LOG_* macros instead of calling log() directly. They check the level before
+     * formatting the message, rate limit each call site separately, and the debug logs are
+     * removed from the release builds.
+     */
+    class Logger
+    {
+    public:
+        /**
+         * The number of slots in the ring buffer. Must be a power of two.
+         * The messages written while the buffer is full are dropped and counted.
+         */
+        static constexpr size_t bufferSize = 256;
+
+        /**
+         * The time the background thread waits after it is woken up by a message, so that the
+         * messages logged together are written in a single batch.
+         */
+        static constexpr unsigned int flushIntervalMs = 100;
+
+        /**
+         * Each call site can write rateLimitBurst messages in every rateLimitWindowMs.
+         */
+        static constexpr unsigned int rateLimitWindowMs = 5000;
+
+        static constexpr unsigned int rateLimitBurst = 10;
+
+        /**
+         * Set the minimum level of the messages that are written. The initial level is read from
+         * the FLWM_LOG_LEVEL environment variable. (debug, info, warning, error or none)
+         */
+        static void setLevel(LogLevel level);
+
+        /**
+         * Returns if the messages of the given level are written.
+         */
+        static bool isEnabled(LogLevel level);
+
+        /**
+         * Format the message and add it to the buffer, if the call site is not rate limited.
+         */
+        static void log(LogLevel level, LogSite *site, const char *format, ...) G_GNUC_PRINTF(3, 4);
+
+    private:
+        static std::atomic<int> level;
+
+        static LogSlot slots[bufferSize];
+
+        /**
+         * The position of the next slot to be written. Shared by all writer threads.
+         */
+        static std::atomic<size_t> writePosition;
+
+        /**
+         * The position of the next slot to be read. Used only by the background thread.
+         */
+        static size_t readPosition;
+
+        /**
+         * The number of messages dropped since the last flush, because the buffer was full.
+         */
+        static std::atomic<unsigned int> droppedCount;
+
+        static std::atomic<bool> isRunning;
+
+        static std::thread thread;
+
+        /**
+         * If the background thread is woken up to write the buffered messages. Set by the first
+         * message logged after a flush, so that only that message takes the mutex.
+         */
+        static std::atomic<bool> isWakeRequested;
+
+        static std::mutex wakeMutex;
+
+        /**
+         * The background thread sleeps on this until a message is logged or the logger is stopped.
+         */
+        static std::condition_variable wakeCondition;
+
+        /**
+         * Initialize the buffer and start the background thread, when the first message is logged.
+         */
+        static void start();
+
+        /**
+         * Flush the remaining messages and stop the background thread, when the process exits.
+         */
+        static void stop();
+
+        /**
+         * The loop of the background thread.
+         */
+        static void run();
+
+        /**
+         * Wake up the background thread, if it is not woken up already.
+         */
+        static void wake();
+
+        /**
+         * Write all buffered messages to stderr.
+         */
+        static void flush();
+
+        /**
+         * Claim a slot in the buffer. Returns NULL if the buffer is full.
+         * The slot must be published with the returned position after it is filled.
+         */
+        static LogSlot *claimSlot(size_t *position);
+    };
+}
+
+/**
+ * Write a log message with the given level and printf style format.
+ */
+#define FLWM_LOG(logLevel, ...)                                      \
+    do                                                               \
+    {                                                                \
+        if (FLWM::Logger::isEnabled(logLevel))                       \
+        {                                                            \
+            static FLWM::LogSite _flwmLogSite;                       \
+            FLWM::Logger::log(logLevel, &_flwmLogSite, __VA_ARGS__); \
+        }                                                            \
+    } while (0)
+
+#ifdef NDEBUG
+#define FLWM_LOG_DEBUG(...) \
+    do                      \
+    {                       \
+    } while (0)
+#else
+#define FLWM_LOG_DEBUG(...) FLWM_LOG(FLWM::LOG_LEVEL_DEBUG, __VA_ARGS__)
+#endif
+
+#define FLWM_LOG_INFO(...) FLWM_LOG(FLWM::LOG_LEVEL_INFO, __VA_ARGS__)
+
+#define FLWM_LOG_WARNING(...) FLWM_LOG(FLWM::LOG_LEVEL_WARNING, __VA_ARGS__)
+
+#define FLWM_LOG_ERROR(...) FLWM_LOG(FLWM::LOG_LEVEL_ERROR, __VA_ARGS__)
@@ -0,0 +1,114 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <glib-unix.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include <event_stream/event_stream.h>
+#include <logger/logger.h>
+#include <memory_monitor/memory_monitor.h>
+#include <window_manager/window_manager.h>
+
+/**
+ * Static member initialization
+ */
+int FLWM::MemoryMonitor::fd = -1;
+guint FLWM::MemoryMonitor::sourceId = 0;
+gint64 FLWM::MemoryMonitor::lastPressureTimeUs = 0;
+
+bool FLWM::MemoryMonitor::start(unsigned int stallMs, unsigned int windowMs) {
+  stop();
+
+  fd = open(pressureFile, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+  if (fd < 0) {
+    FLWM_LOG_WARNING("Cannot open %s, memory pressure is not monitored: %s",
+                     pressureFile, strerror(errno));
+    return false;
+  }
+
+  /// The trigger is registered by writing it to the file, and it is active
+  /// until the file is closed.
+  std::string trigger = "some " + std::to_string(stallMs * 1000) + " " +
+                        std::to_string(windowMs * 1000);
+  if (write(fd, trigger.c_str(), trigger.size() + 1) < 0) {
+    FLWM_LOG_WARNING("Cannot register the memory pressure trigger '%s': %s",
+                     trigger.c_str(), strerror(errno));
+    close(fd);
+    fd = -1;
+    return false;
+  }
+
+  /// The kernel reports the trigger as a priority event on the file.
+  sourceId = g_unix_fd_add(fd, G_IO_PRI, onPressure, NULL);
+  return true;
+}
+
+void FLWM::MemoryMonitor::stop() {
+  if (sourceId != 0) {
+    g_source_remove(sourceId);
+    sourceId = 0;
+  }
+
+  if (fd >= 0) {
+    close(fd);
+    fd = -1;
+  }
+}
+
+bool FLWM::MemoryMonitor::isRunning() { return fd >= 0; }
+
+gboolean FLWM::MemoryMonitor::onPressure(gint fd, GIOCondition condition,
+                                         gpointer userData) {
+  if (condition & (G_IO_ERR | G_IO_HUP | G_IO_NVAL)) {
+    FLWM_LOG_WARNING("The memory pressure monitor is stopped by an error.");
+    sourceId = 0;
+    stop();
+    return G_SOURCE_REMOVE;
+  }
+
+  /// The kernel sends an event at most once in a trigger window, but a stall
+  /// lasting for long triggers in every window. Relieving the pressure again
+  /// so soon only closes more windows without helping.
+  gint64 now = g_get_monotonic_time();
+  if (lastPressureTimeUs > 0 && now - lastPressureTimeUs < G_USEC_PER_SEC) {
+    return G_SOURCE_CONTINUE;
+  }
+  lastPressureTimeUs = now;
+
+  FLWM_LOG_INFO("The system is under memory pressure.");
+  relievePressure();
+
+  return G_SOURCE_CONTINUE;
+}
+
+void FLWM::MemoryMonitor::relievePressure() {
+  std::vector<std::string> closedWindowIds;
+
+  /// The list is copied, since closing a window changes the list.
+  for (const std::string &id : FLWM::WindowManager::getWindowIds()) {
+    FLWM::WindowManager manager(id);
+
+    /// The visible windows are not closed, since the user is looking at them.
+    bool isMapped = gtk_widget_get_mapped(GTK_WIDGET(manager.getGtkWindow()));
+    if (manager.isEvictable() && !isMapped) {
+      manager.closeWindow();
+      closedWindowIds.push_back(id);
+      continue;
+    }
+
+    manager.notifyMemoryPressure();
+  }
+
+  FlValue *closedWindows = fl_value_new_list();
+  for (const std::string &id : closedWindowIds) {
+    fl_value_append_take(closedWindows, fl_value_new_string(id.c_str()));
+  }
+
+  /// This is not related to a single window, so the window ID is empty.
+  FlValue *data = fl_value_new_map();
+  fl_value_set_string_take(data, "closedWindows", closedWindows);
+  FLWM::EventStream::emit("", "memoryPressure", data);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <gtk/gtk.h>
+
+#include <flutter_linux/flutter_linux.h>
+
+namespace FLWM
+{
+    /**
+     * Watches the memory pressure of the system using the pressure stall information (PSI) of the
+     * kernel, and relays it to the engines of all windows.
+     *
+     * When the tasks of the system are stalled on memory for longer than the given threshold in a
+     * time window, the kernel wakes up the monitor. Then every engine is told to release its
+     * caches, the hidden windows marked as evictable are closed, and a "memoryPressure" event is
+     * emitted.
+     */
+    class MemoryMonitor
+    {
+    public:
+        /**
+         * The file of the system wide memory pressure.
+         */
+        static constexpr const char *pressureFile = "/proc/pressure/memory";
+
+        /**
+         * Start watching the memory pressure. The monitor is triggered when some tasks are stalled
+         * on memory for stallMs milliseconds in windowMs milliseconds. (The kernel requires the
+         * window to be between 500ms and 10s. Without CAP_SYS_RESOURCE, it must also be a multiple
+         * of 2s, and the kernel must be Linux 6.5 or newer)
+         *
+         * Returns false if the kernel does not support PSI, or the monitor cannot be started.
+         */
+        static bool start(unsigned int stallMs, unsigned int windowMs);
+
+        /**
+         * Stop watching the memory pressure.
+         */
+        static void stop();
+
+        /**
+         * Returns if the monitor is watching the memory pressure.
+         */
+        static bool isRunning();
+
+    private:
+        /**
+         * The file descriptor of the pressure file, on which the trigger is registered. (-1 if not
+         * running)
+         */
+        static int fd;
+
+        /**
+         * The ID of the GSource that polls the file descriptor. (0 if not running)
+         */
+        static guint sourceId;
+
+        /**
+         * The monotonic time of the last pressure event in microseconds.
+         */
+        static gint64 lastPressureTimeUs;
+
+        static gboolean onPressure(gint fd, GIOCondition condition, gpointer userData);
+
+        /**
+         * Tell every engine to release its caches, and close the hidden evictable windows.
+         */
+        static void relievePressure();
+    };
+}
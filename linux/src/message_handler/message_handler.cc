@@ -1,9 +1,11 @@
-#include <iostream>
-
+#include <event_stream/event_stream.h>
+#include <logger/logger.h>
+#include <memory_monitor/memory_monitor.h>
 #include <message_handler/message_handler.h>
 #include <message_handler/method_call_arg_utils.h>
 #include <message_handler/method_response_utils.h>
 #include <window_manager/window_manager.h>
+#include <window_manager/window_replicator.h>
 
 struct SharedChannelHandlerData {
   /// The window ID to whcich the method call needs to be forwarded.
@@ -13,6 +15,14 @@ struct SharedChannelHandlerData {
   std::string channelName;
 };
 
+/**
+ * Free the handler data of a shared method channel. Called when the handler of
+ * the channel is replaced or the channel is destroyed.
+ */
+void _freeSharedChannelHandlerData(gpointer data) {
+  delete (SharedChannelHandlerData *)data;
+}
+
 /**
  * A proxy method handler that forwards the method call to the given window.
  */
@@ -31,15 +41,71 @@ void sharedMethodChannelHandler(FlMethodChannel *channel,
     fl_method_call_respond(methodCall,
                            FLWM::MethodResponseUtils::successResponse(), NULL);
   } catch (...) {
-    std::cerr
-        << "An error occurred in while handling shared method channel message"
-        << std::endl;
-    g_autoptr(FlMethodErrorResponse) error = fl_method_error_response_new(
-        "method_not_implemented", "Method not implemented", nullptr);
-    fl_method_call_respond(methodCall, FL_METHOD_RESPONSE(error), nullptr);
+    FLWM_LOG_ERROR(
+        "An error occurred in while handling shared method channel message");
+    FLWM::GObjectRef<FlMethodResponse> error(
+        FL_METHOD_RESPONSE(fl_method_error_response_new(
+            "method_not_implemented", "Method not implemented", nullptr)));
+    fl_method_call_respond(methodCall, error, nullptr);
   }
 }
 
+/**
+ * Read the properties of a new window from the method call arguments.
+ */
+FLWM::WindowSpec _getWindowSpec(FlMethodCall *methodCall) {
+  FLWM::WindowSpec spec;
+  spec.title = FLWM::MethodCallArgUtils::getString(methodCall, "title");
+  spec.width = FLWM::MethodCallArgUtils::getInt(methodCall, "width");
+  spec.height = FLWM::MethodCallArgUtils::getInt(methodCall, "height");
+  spec.isLayer = FLWM::MethodCallArgUtils::getBool(methodCall, "isLayer");
+  spec.args = FLWM::MethodCallArgUtils::getStringList(methodCall, "args");
+
+  const char *entrypoint =
+      FLWM::MethodCallArgUtils::getString(methodCall, "entrypoint");
+  spec.entrypoint = entrypoint != nullptr ? entrypoint : "";
+  spec.monitor = FLWM::MethodCallArgUtils::getInt(methodCall, "monitor", -1);
+
+  FLWM::LayerSpec &layer = spec.layer;
+  layer.layer = static_cast<FLWM::Layer>(FLWM::MethodCallArgUtils::getInt(
+      methodCall, "layer", FLWM::LAYER_TOP));
+  layer.anchor = FLWM::MethodCallArgUtils::getInt(methodCall, "anchor", 0);
+  layer.marginTop =
+      FLWM::MethodCallArgUtils::getInt(methodCall, "marginTop", 0);
+  layer.marginRight =
+      FLWM::MethodCallArgUtils::getInt(methodCall, "marginRight", 0);
+  layer.marginBottom =
+      FLWM::MethodCallArgUtils::getInt(methodCall, "marginBottom", 0);
+  layer.marginLeft =
+      FLWM::MethodCallArgUtils::getInt(methodCall, "marginLeft", 0);
+  layer.exclusiveZone =
+      FLWM::MethodCallArgUtils::getInt(methodCall, "exclusiveZone", 0);
+  layer.autoExclusiveZone =
+      FLWM::MethodCallArgUtils::getBool(methodCall, "autoExclusiveZone");
+  layer.keyboardMode =
+      static_cast<FLWM::KeyboardInteractivity>(FLWM::MethodCallArgUtils::getInt(
+          methodCall, "keyboardMode", FLWM::ON_DEMAND));
+
+  const char *layerNamespace =
+      FLWM::MethodCallArgUtils::getString(methodCall, "layerNamespace");
+  layer.layerNamespace = layerNamespace != nullptr ? layerNamespace : "";
+  spec.deferEngine =
+      FLWM::MethodCallArgUtils::getBool(methodCall, "deferEngine");
+  spec.preloadEngine =
+      FLWM::MethodCallArgUtils::getBool(methodCall, "preloadEngine");
+  spec.transparent =
+      FLWM::MethodCallArgUtils::getBool(methodCall, "transparent");
+  spec.engineOptions.traceStartup =
+      FLWM::MethodCallArgUtils::getBool(methodCall, "traceStartup");
+  spec.engineOptions.resourceCacheMaxBytes =
+      FLWM::MethodCallArgUtils::getOptionalInt64(methodCall,
+                                                 "resourceCacheMaxBytes");
+  spec.engineOptions.switches =
+      FLWM::MethodCallArgUtils::getStringList(methodCall, "engineSwitches");
+
+  return spec;
+}
+
 void messageHandler(FlMethodChannel *channel, FlMethodCall *methodCall,
                     gpointer userData) {
   try {
@@ -70,51 +136,85 @@ void messageHandler(FlMethodChannel *channel, FlMethodCall *methodCall,
       FLWM::WindowManager managerDest(shareWithWindowId);
 
       managerSrc.createMethodChannel(channelName, sharedMethodChannelHandler,
-                                     destHandlerData);
+                                     destHandlerData,
+                                     _freeSharedChannelHandlerData);
       managerDest.createMethodChannel(channelName, sharedMethodChannelHandler,
-                                      srcHandlerData);
+                                      srcHandlerData,
+                                      _freeSharedChannelHandlerData);
       
       fl_method_call_respond(methodCall,
                            FLWM::MethodResponseUtils::successResponse(), NULL);
       return;
     }else if (strcmp(methodName, "isWindowIdUsed") == 0) {
-      FlValue *result = nullptr;
-      FlMethodResponse *response = nullptr;
+      FLWM::GObjectRef<FlMethodResponse> response;
 
       std::string id =
           FLWM::MethodCallArgUtils::getString(methodCall, "id");
 
       try {
-        result = FLWM::WindowManager::isWindowIdUsed(id);
-        response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+        FLWM::FlValueRef result(FLWM::WindowManager::isWindowIdUsed(id));
+        response = FLWM::MethodResponseUtils::successResponse(result.get());
       } catch (...) {
-        response = FL_METHOD_RESPONSE(fl_method_error_response_new(
-            "WINDOW_ERROR", "Failed to check if window id is used", nullptr));
+        response.reset(FL_METHOD_RESPONSE(fl_method_error_response_new(
+            "WINDOW_ERROR", "Failed to check if window id is used", nullptr)));
       }
 
-      if (response != nullptr) {
-        fl_method_call_respond(methodCall, response, nullptr);
-        g_object_unref(response);
-      }
+      fl_method_call_respond(methodCall, response, nullptr);
       return;
     } 
      else if (strcmp(methodName, "createWindow") == 0) {
-      std::string title =
-          FLWM::MethodCallArgUtils::getString(methodCall, "title");
-      unsigned int width =
-          FLWM::MethodCallArgUtils::getInt(methodCall, "width");
-      unsigned int height =
-          FLWM::MethodCallArgUtils::getInt(methodCall, "height");
-      bool isLayer = FLWM::MethodCallArgUtils::getBool(methodCall, "isLayer");
-      std::vector<std::string> args =
-          FLWM::MethodCallArgUtils::getStringList(methodCall, "args");
-
-      FLWM::WindowManager::createWindow(windowId, title, width, height, isLayer,
-                                        args);
+      FLWM::WindowManager::createWindow(
+          windowId, _getWindowSpec(methodCall),
+          FLWM::MethodCallArgUtils::getValue(methodCall, "initialPayload"));
       
       fl_method_call_respond(methodCall,
                            FLWM::MethodResponseUtils::successResponse(), NULL);
       return;
+    } else if (strcmp(methodName, "createNativeWindow") == 0) {
+      FLWM::WindowSpec spec = _getWindowSpec(methodCall);
+      spec.isNative = true;
+      spec.color = (uint32_t)FLWM::MethodCallArgUtils::getInt(methodCall,
+                                                              "color", 0);
+
+      const char *eventWindowId =
+          FLWM::MethodCallArgUtils::getString(methodCall, "eventWindowId");
+      spec.eventWindowId = eventWindowId != nullptr ? eventWindowId : "";
+
+      FLWM::WindowManager::createWindow(windowId, spec, nullptr);
+
+      fl_method_call_respond(methodCall,
+                           FLWM::MethodResponseUtils::successResponse(), NULL);
+      return;
+    } else if (strcmp(methodName, "setNativeWindowColor") == 0) {
+      FLWM::WindowManager manager(windowId);
+      uint32_t color =
+          (uint32_t)FLWM::MethodCallArgUtils::getInt(methodCall, "color");
+
+      manager.setNativeColor(color);
+
+      fl_method_call_respond(methodCall,
+                             FLWM::MethodResponseUtils::successResponse(), NULL);
+      return;
+    } else if (strcmp(methodName, "createReplicatedWindow") == 0) {
+      FLWM::WindowReplicator::create(windowId, _getWindowSpec(methodCall));
+
+      fl_method_call_respond(methodCall,
+                           FLWM::MethodResponseUtils::successResponse(), NULL);
+      return;
+    } else if (strcmp(methodName, "closeReplicatedWindow") == 0) {
+      FLWM::WindowReplicator::close(windowId);
+
+      fl_method_call_respond(methodCall,
+                           FLWM::MethodResponseUtils::successResponse(), NULL);
+      return;
+    } else if (strcmp(methodName, "getReplicatedWindowInstances") == 0) {
+      FLWM::FlValueRef instances(
+          FLWM::WindowReplicator::getInstances(windowId));
+
+      fl_method_call_respond(
+          methodCall,
+          FLWM::MethodResponseUtils::successResponse(instances.get()), NULL);
+      return;
     } else if (strcmp(methodName, "setLayer") == 0) {
       FLWM::WindowManager manager(windowId);
       FLWM::Layer layer =
@@ -147,6 +247,16 @@ void messageHandler(FlMethodChannel *channel, FlMethodCall *methodCall,
       fl_method_call_respond(methodCall,
                            FLWM::MethodResponseUtils::successResponse(), NULL);
       return;
+    } else if (strcmp(methodName, "setLayerNamespace") == 0) {
+      FLWM::WindowManager manager(windowId);
+      std::string layerNamespace =
+          FLWM::MethodCallArgUtils::getString(methodCall, "layerNamespace");
+
+      manager.setLayerNamespace(layerNamespace);
+
+      fl_method_call_respond(methodCall,
+                             FLWM::MethodResponseUtils::successResponse(), NULL);
+      return;
     } else if (strcmp(methodName, "setLayerMargin") == 0) {
       FLWM::WindowManager manager(windowId);
       unsigned int top = FLWM::MethodCallArgUtils::getInt(methodCall, "top");
@@ -223,7 +333,11 @@ void messageHandler(FlMethodChannel *channel, FlMethodCall *methodCall,
       return;
     } else if (strcmp(methodName, "hideWindow") == 0) {
       FLWM::WindowManager manager(windowId);
-      manager.hideWindow();
+      bool notifyMemoryPressure =
+          FLWM::MethodCallArgUtils::getBool(methodCall, "notifyMemoryPressure");
+      bool soft = FLWM::MethodCallArgUtils::getBool(methodCall, "soft");
+
+      manager.hideWindow(notifyMemoryPressure, soft);
       
       fl_method_call_respond(methodCall,
                            FLWM::MethodResponseUtils::successResponse(), NULL);
@@ -244,22 +358,18 @@ void messageHandler(FlMethodChannel *channel, FlMethodCall *methodCall,
       return;
     }
     else if (strcmp(methodName, "isVisible") == 0) {
-      FlValue *result = nullptr;
-      FlMethodResponse *response = nullptr;
+      FLWM::GObjectRef<FlMethodResponse> response;
 
       try {
         FLWM::WindowManager manager(windowId);
-        result = manager.isVisible();
-        response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+        FLWM::FlValueRef result(manager.isVisible());
+        response = FLWM::MethodResponseUtils::successResponse(result.get());
       } catch (...) {
-        response = FL_METHOD_RESPONSE(fl_method_error_response_new(
-            "WINDOW_ERROR", "Failed to check visibility", nullptr));
+        response.reset(FL_METHOD_RESPONSE(fl_method_error_response_new(
+            "WINDOW_ERROR", "Failed to check visibility", nullptr)));
       }
 
-      if (response != nullptr) {
-        fl_method_call_respond(methodCall, response, nullptr);
-        g_object_unref(response);
-      }
+      fl_method_call_respond(methodCall, response, nullptr);
       return;
     } else if (strcmp(methodName, "setInfinteInputRegion") == 0) {
       FLWM::WindowManager manager(windowId);
@@ -292,13 +402,210 @@ void messageHandler(FlMethodChannel *channel, FlMethodCall *methodCall,
       fl_method_call_respond(methodCall,
                            FLWM::MethodResponseUtils::successResponse(), NULL);
       return;
+    } else if (strcmp(methodName, "clearOpaqueRegion") == 0) {
+      FLWM::WindowManager manager(windowId);
+      manager.clearOpaqueRegion();
+
+      fl_method_call_respond(methodCall,
+                             FLWM::MethodResponseUtils::successResponse(), NULL);
+      return;
+    } else if (strcmp(methodName, "addOpaqueRegion") == 0) {
+      FLWM::WindowManager manager(windowId);
+      int x = FLWM::MethodCallArgUtils::getInt(methodCall, "x");
+      int y = FLWM::MethodCallArgUtils::getInt(methodCall, "y");
+      int width = FLWM::MethodCallArgUtils::getInt(methodCall, "width");
+      int height = FLWM::MethodCallArgUtils::getInt(methodCall, "height");
+
+      manager.addOpaqueRegion(x, y, width, height);
+
+      fl_method_call_respond(methodCall,
+                             FLWM::MethodResponseUtils::successResponse(), NULL);
+      return;
+    } else if (strcmp(methodName, "subtractOpaqueRegion") == 0) {
+      FLWM::WindowManager manager(windowId);
+      int x = FLWM::MethodCallArgUtils::getInt(methodCall, "x");
+      int y = FLWM::MethodCallArgUtils::getInt(methodCall, "y");
+      int width = FLWM::MethodCallArgUtils::getInt(methodCall, "width");
+      int height = FLWM::MethodCallArgUtils::getInt(methodCall, "height");
+
+      manager.subtractOpaqueRegion(x, y, width, height);
+
+      fl_method_call_respond(methodCall,
+                             FLWM::MethodResponseUtils::successResponse(), NULL);
+      return;
+    } else if (strcmp(methodName, "setInputRegionMask") == 0) {
+      FLWM::WindowManager manager(windowId);
+      FlValue *data = FLWM::MethodCallArgUtils::getValue(methodCall, "mask");
+
+      FLWM::Mask mask = {};
+      if (data != NULL && fl_value_get_type(data) == FL_VALUE_TYPE_UINT8_LIST) {
+        mask.data = fl_value_get_uint8_list(data);
+        mask.length = fl_value_get_length(data);
+      }
+      mask.width = FLWM::MethodCallArgUtils::getInt(methodCall, "width");
+      mask.height = FLWM::MethodCallArgUtils::getInt(methodCall, "height");
+      mask.format = static_cast<FLWM::MaskFormat>(
+          FLWM::MethodCallArgUtils::getInt(methodCall, "format", 0));
+      mask.threshold = (uint8_t)FLWM::MethodCallArgUtils::getInt(
+          methodCall, "threshold", 0);
+      double pixelRatio =
+          FLWM::MethodCallArgUtils::getDouble(methodCall, "pixelRatio");
+
+      if (!manager.setInputRegionMask(mask, pixelRatio)) {
+        FLWM::GObjectRef<FlMethodResponse> error(
+            FL_METHOD_RESPONSE(fl_method_error_response_new(
+                "INVALID_MASK", "The mask is smaller than its size", nullptr)));
+        fl_method_call_respond(methodCall, error, NULL);
+        return;
+      }
+
+      fl_method_call_respond(methodCall,
+                             FLWM::MethodResponseUtils::successResponse(), NULL);
+      return;
+    } else if (strcmp(methodName, "setFrameTelemetry") == 0) {
+      FLWM::WindowManager manager(windowId);
+      bool enabled = FLWM::MethodCallArgUtils::getBool(methodCall, "enabled");
+
+      manager.setFrameTelemetry(enabled);
+
+      fl_method_call_respond(methodCall,
+                           FLWM::MethodResponseUtils::successResponse(), NULL);
+      return;
+    } else if (strcmp(methodName, "animateGeometry") == 0) {
+      FLWM::WindowManager manager(windowId);
+
+      FLWM::WindowGeometry target;
+      target.width =
+          FLWM::MethodCallArgUtils::getOptionalInt(methodCall, "width");
+      target.height =
+          FLWM::MethodCallArgUtils::getOptionalInt(methodCall, "height");
+      target.marginTop =
+          FLWM::MethodCallArgUtils::getOptionalInt(methodCall, "marginTop");
+      target.marginRight =
+          FLWM::MethodCallArgUtils::getOptionalInt(methodCall, "marginRight");
+      target.marginBottom =
+          FLWM::MethodCallArgUtils::getOptionalInt(methodCall, "marginBottom");
+      target.marginLeft =
+          FLWM::MethodCallArgUtils::getOptionalInt(methodCall, "marginLeft");
+      target.exclusiveZone =
+          FLWM::MethodCallArgUtils::getOptionalInt(methodCall, "exclusiveZone");
+
+      unsigned int durationMs =
+          FLWM::MethodCallArgUtils::getInt(methodCall, "durationMs");
+      FLWM::AnimationCurve curve =
+          (FLWM::AnimationCurve)FLWM::MethodCallArgUtils::getInt(
+              methodCall, "curve", FLWM::CURVE_LINEAR);
+
+      int animationId =
+          FLWM::MethodCallArgUtils::getInt(methodCall, "animationId");
+
+      manager.animateGeometry(animationId, target, durationMs, curve);
+
+      fl_method_call_respond(methodCall,
+                           FLWM::MethodResponseUtils::successResponse(), NULL);
+      return;
+    } else if (strcmp(methodName, "stopGeometryAnimation") == 0) {
+      FLWM::WindowManager manager(windowId);
+
+      manager.stopGeometryAnimation();
+
+      fl_method_call_respond(methodCall,
+                           FLWM::MethodResponseUtils::successResponse(), NULL);
+      return;
+    } else if (strcmp(methodName, "getFrameStats") == 0) {
+      FLWM::WindowManager manager(windowId);
+      FLWM::FlValueRef stats_value(manager.getFrameStats());
+
+      fl_method_call_respond(
+          methodCall,
+          FLWM::MethodResponseUtils::successResponse(stats_value.get()), NULL);
+      return;
+    } else if (strcmp(methodName, "getScale") == 0) {
+      FLWM::WindowManager manager(windowId);
+      FLWM::FlValueRef scale_value(manager.getScale());
+
+      fl_method_call_respond(
+          methodCall,
+          FLWM::MethodResponseUtils::successResponse(scale_value.get()), NULL);
+      return;
+    } else if (strcmp(methodName, "takeInitialPayload") == 0) {
+      /// The payload is taken by the window that sent the method call.
+      FLWM::WindowManager manager((const char *)userData);
+      FLWM::FlValueRef payload(manager.takeInitialPayload());
+
+      fl_method_call_respond(
+          methodCall, FLWM::MethodResponseUtils::successResponse(payload.get()),
+          NULL);
+      return;
+    } else if (strcmp(methodName, "startMemoryMonitor") == 0) {
+      unsigned int stallMs =
+          FLWM::MethodCallArgUtils::getInt(methodCall, "stallMs", 300);
+      unsigned int windowMs =
+          FLWM::MethodCallArgUtils::getInt(methodCall, "windowMs", 2000);
+
+      bool isStarted = FLWM::MemoryMonitor::start(stallMs, windowMs);
+
+      FLWM::FlValueRef result(fl_value_new_bool(isStarted));
+      fl_method_call_respond(
+          methodCall, FLWM::MethodResponseUtils::successResponse(result.get()),
+          NULL);
+      return;
+    } else if (strcmp(methodName, "stopMemoryMonitor") == 0) {
+      FLWM::MemoryMonitor::stop();
+
+      fl_method_call_respond(methodCall,
+                             FLWM::MethodResponseUtils::successResponse(), NULL);
+      return;
+    } else if (strcmp(methodName, "setEvictable") == 0) {
+      FLWM::WindowManager manager(windowId);
+      bool evictable = FLWM::MethodCallArgUtils::getBool(methodCall, "evictable");
+
+      manager.setEvictable(evictable);
+
+      fl_method_call_respond(methodCall,
+                             FLWM::MethodResponseUtils::successResponse(), NULL);
+      return;
+    } else if (strcmp(methodName, "getMemoryUsage") == 0) {
+      FLWM::FlValueRef usage(FLWM::WindowManager::getMemoryUsage());
+
+      fl_method_call_respond(
+          methodCall, FLWM::MethodResponseUtils::successResponse(usage.get()),
+          NULL);
+      return;
+    } else if (strcmp(methodName, "setEventSubscriptions") == 0) {
+      /// The subscriptions belong to the engine that sent the method call.
+      FLWM::EventStream::subscribe(
+          (const char *)userData,
+          FLWM::MethodCallArgUtils::getStringList(methodCall, "windowIds"),
+          FLWM::MethodCallArgUtils::getBool(methodCall, "allWindows"));
+
+      fl_method_call_respond(methodCall,
+                             FLWM::MethodResponseUtils::successResponse(),
+                             NULL);
+      return;
+    } else if (strcmp(methodName, "getHandleCounts") == 0) {
+      FLWM::FlValueRef counts(FLWM::HandleCounter::getCounts());
+
+      fl_method_call_respond(
+          methodCall,
+          FLWM::MethodResponseUtils::successResponse(counts.get()), NULL);
+      return;
     } else if (strcmp(methodName, "getMonitorList") == 0) {
       FLWM::WindowManager manager(windowId);
-      g_autoptr(FlValue) monitors_value = manager.getMonitorList();
+      FLWM::FlValueRef monitors_value(manager.getMonitorList());
 
       fl_method_call_respond(
           methodCall,
-          FLWM::MethodResponseUtils::successResponse(monitors_value), NULL);
+          FLWM::MethodResponseUtils::successResponse(monitors_value.get()),
+          NULL);
+      return;
+    } else if (strcmp(methodName, "getMonitors") == 0) {
+      FLWM::FlValueRef monitors_value(FLWM::WindowManager::getMonitors());
+
+      fl_method_call_respond(
+          methodCall,
+          FLWM::MethodResponseUtils::successResponse(monitors_value.get()),
+          NULL);
       return;
     } else if (strcmp(methodName, "setMonitor") == 0) {
       FLWM::WindowManager manager(windowId);
@@ -309,8 +616,19 @@ void messageHandler(FlMethodChannel *channel, FlMethodCall *methodCall,
       fl_method_call_respond(methodCall,
                            FLWM::MethodResponseUtils::successResponse(), NULL);
       return;
+    } else if (strcmp(methodName, "migrateToMonitor") == 0) {
+      FLWM::WindowManager manager(windowId);
+      int monitor = FLWM::MethodCallArgUtils::getInt(methodCall, "monitor");
+
+      bool isStarted = manager.migrateToMonitor(monitor);
+
+      FLWM::FlValueRef result(fl_value_new_bool(isStarted));
+      fl_method_call_respond(
+          methodCall, FLWM::MethodResponseUtils::successResponse(result.get()),
+          NULL);
+      return;
     } else {
-      std::cerr << "Method not implemented: " << methodName << std::endl;
+      FLWM_LOG_WARNING("Method not implemented: %s", methodName);
       fl_method_call_respond(
           methodCall, FLWM::MethodResponseUtils::methodNotImplementedError(),
           NULL);
@@ -318,10 +636,10 @@ void messageHandler(FlMethodChannel *channel, FlMethodCall *methodCall,
     }
   }
   catch (...) {
-    std::cerr << "An error occurred while handling method channel message"
-              << std::endl;
-    g_autoptr(FlMethodErrorResponse) error = fl_method_error_response_new(
-        "method_not_implemented", "Method not implemented", nullptr);
-    fl_method_call_respond(methodCall, FL_METHOD_RESPONSE(error), nullptr);
+    FLWM_LOG_ERROR("An error occurred while handling method channel message");
+    FLWM::GObjectRef<FlMethodResponse> error(
+        FL_METHOD_RESPONSE(fl_method_error_response_new(
+            "method_not_implemented", "Method not implemented", nullptr)));
+    fl_method_call_respond(methodCall, error, nullptr);
   }
 }
\ No newline at end of file
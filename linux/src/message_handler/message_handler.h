@@ -10,7 +10,7 @@
  * The parameter methodCall represents the FlMethodCall* that contains the method name and arguments.
  *
  * The parameter userData is the user data that was passed when the callback was registered.
- * (In this case it will be NULL).
+ * (In this case it is the ID of the window whose engine sent the method call, as a string)
  */
 void messageHandler(FlMethodChannel* channel, FlMethodCall* methodCall,
     gpointer userData);
\ No newline at end of file
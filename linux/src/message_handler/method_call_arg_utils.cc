@@ -1,5 +1,4 @@
-#include <iostream>
-
+#include <logger/logger.h>
 #include <message_handler/method_call_arg_utils.h>
 
 int FLWM::MethodCallArgUtils::getInt(FlMethodCall* method_call, const char* argument_name) {
@@ -13,6 +12,33 @@ int FLWM::MethodCallArgUtils::getInt(FlMethodCall* method_call, const char* argu
     return fl_value_get_int(argument);
 }
 
+int FLWM::MethodCallArgUtils::getInt(FlMethodCall* method_call, const char* argument_name, int default_value) {
+    if (!hasArgument(method_call, argument_name, FL_VALUE_TYPE_INT)) {
+        return default_value;
+    }
+
+    return getInt(method_call, argument_name);
+}
+
+std::optional<int> FLWM::MethodCallArgUtils::getOptionalInt(FlMethodCall* method_call, const char* argument_name) {
+    if (!hasArgument(method_call, argument_name, FL_VALUE_TYPE_INT)) {
+        return std::nullopt;
+    }
+
+    return getInt(method_call, argument_name);
+}
+
+std::optional<int64_t> FLWM::MethodCallArgUtils::getOptionalInt64(FlMethodCall* method_call, const char* argument_name) {
+    if (!hasArgument(method_call, argument_name, FL_VALUE_TYPE_INT)) {
+        return std::nullopt;
+    }
+
+    FlValue* argsMap = fl_method_call_get_args(method_call);
+    FlValue* argument = fl_value_lookup_string(argsMap, argument_name);
+
+    return fl_value_get_int(argument);
+}
+
 const char* FLWM::MethodCallArgUtils::getString(FlMethodCall* method_call, const char* argument_name) {
     if (!hasArgument(method_call, argument_name, FL_VALUE_TYPE_STRING)) {
         return nullptr;
@@ -46,6 +72,20 @@ bool FLWM::MethodCallArgUtils::getBool(FlMethodCall* method_call, const char* ar
     return fl_value_get_bool(argument);
 }
 
+FlValue* FLWM::MethodCallArgUtils::getValue(FlMethodCall* method_call, const char* argument_name) {
+    FlValue* argsMap = fl_method_call_get_args(method_call);
+    if (argsMap == nullptr || fl_value_get_type(argsMap) != FL_VALUE_TYPE_MAP) {
+        return nullptr;
+    }
+
+    FlValue* argument = fl_value_lookup_string(argsMap, argument_name);
+    if (argument == nullptr || fl_value_get_type(argument) == FL_VALUE_TYPE_NULL) {
+        return nullptr;
+    }
+
+    return argument;
+}
+
 std::vector<std::string> FLWM::MethodCallArgUtils::getStringList(FlMethodCall* methodCall, const char* argumentName) {
     if (!hasArgument(methodCall, argumentName, FL_VALUE_TYPE_LIST)) {
         return std::vector<std::string>();
@@ -70,7 +110,7 @@ bool FLWM::MethodCallArgUtils::hasArgument(FlMethodCall* method_call,
 
     /// Check if the arguemnts map is empty.
     if (argsMap == nullptr || fl_value_get_type(argsMap) != FL_VALUE_TYPE_MAP) {
-        std::cout << "Arguments map is empty. Cannot get " << argument_name << " arguement." << std::endl;
+        FLWM_LOG_DEBUG("Arguments map is empty. Cannot get %s arguement.", argument_name);
 
         return false;
     }
@@ -78,17 +118,16 @@ bool FLWM::MethodCallArgUtils::hasArgument(FlMethodCall* method_call,
     /// Check if the argument is present in the arguments map.
     FlValue* value = fl_value_lookup_string(argsMap, argument_name);
 
-    if (value == nullptr) {
-        std::cout << "Argument with name '" << argument_name
-            << "' is not found in the method args map." << std::endl;
+    if (value == nullptr || fl_value_get_type(value) == FL_VALUE_TYPE_NULL) {
+        /// Optional arguments are not sent by the dart code, so this is not an error.
+        FLWM_LOG_DEBUG("Argument with name '%s' is not found in the method args map.", argument_name);
 
         return false;
     }
 
     /// Check if the argument is of the correct type.
     if (fl_value_get_type(value) != argument_type) {
-        std::cout << "Argument with name '" << argument_name
-            << "' is not of the correct type." << std::endl;
+        FLWM_LOG_WARNING("Argument with name '%s' is not of the correct type.", argument_name);
 
         return false;
     }
@@ -2,6 +2,8 @@
 
 #include <flutter_linux/flutter_linux.h>
 
+#include <optional>
+#include <stdint.h>
 #include <vector>
 #include <string>
 
@@ -26,6 +28,38 @@ namespace FLWM {
          */
         static int getInt(FlMethodCall* methodCall, const char* argumentName);
 
+        /**
+         * @brief Get the integer argument from the method call, or the default value if the
+         * argument is not present.
+         *
+         * @param methodCall  The method call from which the argument needs to be extracted.
+         * @param argumentName  The name of the argument that needs to be extracted.
+         * @param defaultValue  The value returned if the argument is not present.
+         *
+         * return int  The integer argument extracted from the method call.
+         */
+        static int getInt(FlMethodCall* methodCall, const char* argumentName, int defaultValue);
+
+        /**
+         * @brief Get the integer argument from the method call, if it is present.
+         *
+         * @param methodCall  The method call from which the argument needs to be extracted.
+         * @param argumentName  The name of the argument that needs to be extracted.
+         *
+         * return std::optional<int>  The integer argument, or an empty value if it is not present.
+         */
+        static std::optional<int> getOptionalInt(FlMethodCall* methodCall, const char* argumentName);
+
+        /**
+         * @brief Get the 64-bit integer argument from the method call, if it is present.
+         *
+         * @param methodCall  The method call from which the argument needs to be extracted.
+         * @param argumentName  The name of the argument that needs to be extracted.
+         *
+         * return std::optional<int64_t>  The integer argument, or an empty value if it is not present.
+         */
+        static std::optional<int64_t> getOptionalInt64(FlMethodCall* methodCall, const char* argumentName);
+
         /**
          * @brief Get the string argument from the method call.
          *
@@ -56,6 +90,16 @@ namespace FLWM {
          */
         static bool getBool(FlMethodCall* methodCall, const char* argumentName);
 
+        /**
+         * @brief Get the argument from the method call as it is.
+         *
+         * @param methodCall  The method call from which the argument needs to be extracted.
+         * @param argumentName  The name of the argument that needs to be extracted.
+         *
+         * return FlValue*  The argument, owned by the method call. (nullptr if it is not present)
+         */
+        static FlValue* getValue(FlMethodCall* methodCall, const char* argumentName);
+
         /**
          * @brief Get the list of strings from the method call.
          *
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <flutter_linux/flutter_linux.h>
+#include <handles/handles.h>
 
 namespace FLWM
 {
@@ -9,6 +10,8 @@ namespace FLWM
      *
      * A response can be a success response or an error response. This class allows
      * to create both types of responses.
+     *
+     * The responses are returned as handles, so they are released after being sent.
      */
     class MethodResponseUtils
     {
@@ -16,54 +19,62 @@ namespace FLWM
         /**
          * @brief Create a method not implemented error back to the flutter code.
          *
-         * @return FlMethodResponse* the error response that needs to be sent back to the flutter code.
+         * @return GObjectRef<FlMethodResponse> the error response that needs to be sent back to the flutter code.
          */
-        static FlMethodResponse *methodNotImplementedError();
+        static GObjectRef<FlMethodResponse> methodNotImplementedError();
 
         /**
          * @brief Create a NULL success response back to the flutter code.
          *
-         * @return FlMethodResponse* the response with the given value that needs to be
+         * @return GObjectRef<FlMethodResponse> the response with the given value that needs to be
          * sent back to the flutter code.
          */
-        static FlMethodResponse *successResponse();
+        static GObjectRef<FlMethodResponse> successResponse();
 
         /**
          * @brief Create a INT success response back to the flutter code.
          *
          * @param value  The result that needs to be sent back to the flutter code.
-         * @return FlMethodResponse* the response with the given value that needs to be
+         * @return GObjectRef<FlMethodResponse> the response with the given value that needs to be
          * sent back to the flutter code.
          */
-        static FlMethodResponse *successResponse(int value);
+        static GObjectRef<FlMethodResponse> successResponse(int value);
 
         /**
          * @brief Create a STRING success response back to the flutter code.
          *
          * @param value  The result that needs to be sent back to the flutter code.
-         * @return FlMethodResponse* the response with the given value that needs to be
+         * @return GObjectRef<FlMethodResponse> the response with the given value that needs to be
          * sent back to the flutter code.
          */
-        static FlMethodResponse *successResponse(const char *value);
+        static GObjectRef<FlMethodResponse> successResponse(const char *value);
 
         /**
          * @brief Create a DOUBLE success response back to the flutter code.
          *
          * @param value  The result that needs to be sent back to the flutter code.
-         * @return FlMethodResponse* the response with the given value that needs to be
+         * @return GObjectRef<FlMethodResponse> the response with the given value that needs to be
          * sent back to the flutter code.
          */
-        static FlMethodResponse *successResponse(double value);
+        static GObjectRef<FlMethodResponse> successResponse(double value);
 
         /**
          * @brief Create a BOOL success response back to the flutter code.
          *
          * @param value  The result that needs to be sent back to the flutter code.
-         * @return FlMethodResponse* the response with the given value that needs to be
+         * @return GObjectRef<FlMethodResponse> the response with the given value that needs to be
          * sent back to the flutter code.
          */
-        static FlMethodResponse *successResponse(bool value);
+        static GObjectRef<FlMethodResponse> successResponse(bool value);
 
-        static FlMethodResponse *successResponse(FlValue *value);
-        };
+        /**
+         * @brief Create a success response with the given value back to the flutter code.
+         *
+         * @param value  The result that needs to be sent back to the flutter code. The response
+         * takes its own reference of the value.
+         * @return GObjectRef<FlMethodResponse> the response with the given value that needs to be
+         * sent back to the flutter code.
+         */
+        static GObjectRef<FlMethodResponse> successResponse(FlValue *value);
+    };
 }
\ No newline at end of file
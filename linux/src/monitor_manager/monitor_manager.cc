@@ -0,0 +1,289 @@
+#include <algorithm>
+
+#include <event_stream/event_stream.h>
+#include <logger/logger.h>
+#include <monitor_manager/monitor_manager.h>
+
+/**
+ * Static member initialization
+ */
+GdkDisplay *FLWM::MonitorManager::display = NULL;
+std::vector<FLWM::Monitor> FLWM::MonitorManager::monitors;
+FlValue *FLWM::MonitorManager::monitorListValue = NULL;
+FlValue *FLWM::MonitorManager::monitorsValue = NULL;
+bool FLWM::MonitorManager::isDirty = true;
+guint FLWM::MonitorManager::refreshSourceId = 0;
+std::map<uint32_t, FLWM::Output> FLWM::MonitorManager::outputs;
+std::vector<FLWM::MonitorsChangedCallback> FLWM::MonitorManager::listeners;
+
+void FLWM::MonitorManager::init(GdkDisplay *display) {
+  if (MonitorManager::display != NULL) {
+    return;
+  }
+
+  MonitorManager::display = display;
+
+  g_signal_connect(display, "monitor-added", G_CALLBACK(onMonitorAdded), NULL);
+  g_signal_connect(display, "monitor-removed", G_CALLBACK(onMonitorRemoved),
+                   NULL);
+
+  int n_monitors = gdk_display_get_n_monitors(display);
+  for (int i = 0; i < n_monitors; i++) {
+    GdkMonitor *monitor = gdk_display_get_monitor(display, i);
+    g_signal_connect(monitor, "notify", G_CALLBACK(onMonitorChanged), NULL);
+  }
+
+  isDirty = true;
+}
+
+void _onOutputGeometry(void *data, struct wl_output *wl_output, int32_t x,
+                       int32_t y, int32_t physical_width,
+                       int32_t physical_height, int32_t subpixel,
+                       const char *make, const char *model,
+                       int32_t transform) {
+  FLWM::Output *output = (FLWM::Output *)data;
+  output->x = x;
+  output->y = y;
+  output->make = make != NULL ? make : "";
+  output->model = model != NULL ? model : "";
+}
+
+void _onOutputName(void *data, struct wl_output *wl_output, const char *name) {
+  FLWM::Output *output = (FLWM::Output *)data;
+  output->name = name != NULL ? name : "";
+}
+
+void FLWM::MonitorManager::bindOutput(struct wl_registry *registry,
+                                      uint32_t name, uint32_t version) {
+  /// The "done" event is available only from version 2, and the connector
+  /// name only from version 4.
+  if (version < 2) {
+    return;
+  }
+
+  static const struct wl_output_listener outputListener = {
+      .geometry = _onOutputGeometry,
+      .mode = [](void *data, struct wl_output *wl_output, uint32_t flags,
+                 int32_t width, int32_t height, int32_t refresh) {},
+      .done = [](void *data,
+                 struct wl_output *wl_output) { scheduleRefresh(); },
+      .scale = [](void *data, struct wl_output *wl_output, int32_t factor) {},
+      .name = _onOutputName,
+      .description = [](void *data, struct wl_output *wl_output,
+                        const char *description) {},
+  };
+
+  Output output;
+  output.output = (struct wl_output *)wl_registry_bind(
+      registry, name, &wl_output_interface, std::min(version, 4u));
+  output.x = 0;
+  output.y = 0;
+  outputs[name] = output;
+
+  /// The record in the map is used as the user data, since its address does
+  /// not change until it is removed from the map.
+  wl_output_add_listener(output.output, &outputListener, &outputs[name]);
+}
+
+void FLWM::MonitorManager::unbindOutput(uint32_t name) {
+  auto iter = outputs.find(name);
+  if (iter == outputs.end()) {
+    return;
+  }
+
+  if (wl_proxy_get_version((struct wl_proxy *)iter->second.output) >= 3) {
+    wl_output_release(iter->second.output);
+  } else {
+    wl_output_destroy(iter->second.output);
+  }
+  outputs.erase(iter);
+
+  scheduleRefresh();
+}
+
+FlValue *FLWM::MonitorManager::getMonitorList() {
+  refresh();
+
+  if (monitorListValue == NULL) {
+    return fl_value_new_list();
+  }
+  return fl_value_ref(monitorListValue);
+}
+
+FlValue *FLWM::MonitorManager::getMonitors() {
+  refresh();
+
+  if (monitorsValue == NULL) {
+    return fl_value_new_list();
+  }
+  return fl_value_ref(monitorsValue);
+}
+
+const std::vector<FLWM::Monitor> &FLWM::MonitorManager::getMonitorRecords() {
+  refresh();
+
+  return monitors;
+}
+
+void FLWM::MonitorManager::addListener(MonitorsChangedCallback callback) {
+  listeners.push_back(callback);
+}
+
+void FLWM::MonitorManager::scheduleRefresh() {
+  isDirty = true;
+
+  if (refreshSourceId == 0) {
+    refreshSourceId = g_idle_add(onRefresh, NULL);
+  }
+}
+
+gboolean FLWM::MonitorManager::onRefresh(gpointer userData) {
+  refreshSourceId = 0;
+  refresh();
+
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * Create a map value with the given rectangle.
+ */
+FlValue *_rectangleToValue(const GdkRectangle &rectangle) {
+  FlValue *value = fl_value_new_map();
+  fl_value_set_string_take(value, "x", fl_value_new_int(rectangle.x));
+  fl_value_set_string_take(value, "y", fl_value_new_int(rectangle.y));
+  fl_value_set_string_take(value, "width", fl_value_new_int(rectangle.width));
+  fl_value_set_string_take(value, "height",
+                           fl_value_new_int(rectangle.height));
+  return value;
+}
+
+void FLWM::MonitorManager::refresh() {
+  if (!isDirty) {
+    return;
+  }
+  isDirty = false;
+
+  GdkDisplay *gdkDisplay = display != NULL ? display : gdk_display_get_default();
+  if (gdkDisplay == NULL) {
+    FLWM_LOG_ERROR("Failed to get default GDK display.");
+    return;
+  }
+
+  monitors.clear();
+
+  FlValue *newMonitorList = fl_value_new_list();
+  FlValue *newMonitors = fl_value_new_list();
+
+  int n_monitors = gdk_display_get_n_monitors(gdkDisplay);
+  for (int i = 0; i < n_monitors; i++) {
+    GdkMonitor *gdkMonitor = gdk_display_get_monitor(gdkDisplay, i);
+    if (gdkMonitor == NULL) {
+      continue;
+    }
+
+    const char *manufacturer = gdk_monitor_get_manufacturer(gdkMonitor);
+    const char *model = gdk_monitor_get_model(gdkMonitor);
+
+    Monitor monitor;
+    monitor.index = i;
+    monitor.connector = findConnector(gdkMonitor);
+    monitor.manufacturer = manufacturer != NULL ? manufacturer : "";
+    monitor.model = model != NULL ? model : "Unknown";
+    gdk_monitor_get_geometry(gdkMonitor, &monitor.geometry);
+    gdk_monitor_get_workarea(gdkMonitor, &monitor.workarea);
+    monitor.scaleFactor = gdk_monitor_get_scale_factor(gdkMonitor);
+    monitor.refreshRate = gdk_monitor_get_refresh_rate(gdkMonitor);
+    monitor.gdkMonitor = gdkMonitor;
+    monitors.push_back(monitor);
+
+    gchar *val = g_strdup_printf("%i:%s", i, monitor.model.c_str());
+    fl_value_append_take(newMonitorList, fl_value_new_string(val));
+    g_free(val);
+
+    FlValue *value = fl_value_new_map();
+    fl_value_set_string_take(value, "index", fl_value_new_int(i));
+    fl_value_set_string_take(value, "connector",
+                             fl_value_new_string(monitor.connector.c_str()));
+    fl_value_set_string_take(
+        value, "manufacturer",
+        fl_value_new_string(monitor.manufacturer.c_str()));
+    fl_value_set_string_take(value, "model",
+                             fl_value_new_string(monitor.model.c_str()));
+    fl_value_set_string_take(value, "geometry",
+                             _rectangleToValue(monitor.geometry));
+    fl_value_set_string_take(value, "workarea",
+                             _rectangleToValue(monitor.workarea));
+    fl_value_set_string_take(value, "scaleFactor",
+                             fl_value_new_int(monitor.scaleFactor));
+    fl_value_set_string_take(value, "refreshRate",
+                             fl_value_new_float(monitor.refreshRate / 1000.0));
+    fl_value_append_take(newMonitors, value);
+  }
+
+  bool isChanged =
+      monitorsValue == NULL || !fl_value_equal(monitorsValue, newMonitors);
+
+  if (monitorListValue != NULL) {
+    fl_value_unref(monitorListValue);
+  }
+  if (monitorsValue != NULL) {
+    fl_value_unref(monitorsValue);
+  }
+  monitorListValue = newMonitorList;
+  monitorsValue = newMonitors;
+
+  /// Notify the dart code only when something is actually changed, since
+  /// the notify signals are emitted for each property separately.
+  if (isChanged) {
+    FlValue *data = fl_value_new_map();
+    fl_value_set_string(data, "monitors", monitorsValue);
+    FLWM::EventStream::emit("", "monitorsChanged", data);
+
+    for (MonitorsChangedCallback callback : listeners) {
+      callback();
+    }
+  }
+}
+
+void FLWM::MonitorManager::onMonitorAdded(GdkDisplay *display,
+                                          GdkMonitor *monitor,
+                                          gpointer userData) {
+  g_signal_connect(monitor, "notify", G_CALLBACK(onMonitorChanged), NULL);
+  scheduleRefresh();
+}
+
+void FLWM::MonitorManager::onMonitorRemoved(GdkDisplay *display,
+                                            GdkMonitor *monitor,
+                                            gpointer userData) {
+  g_signal_handlers_disconnect_by_func(monitor, (gpointer)onMonitorChanged,
+                                       NULL);
+  scheduleRefresh();
+}
+
+void FLWM::MonitorManager::onMonitorChanged(GdkMonitor *monitor,
+                                            GParamSpec *paramSpec,
+                                            gpointer userData) {
+  scheduleRefresh();
+}
+
+std::string FLWM::MonitorManager::findConnector(GdkMonitor *monitor) {
+  const char *model = gdk_monitor_get_model(monitor);
+  GdkRectangle geometry;
+  gdk_monitor_get_geometry(monitor, &geometry);
+
+  /// The GDK monitor and the output bound by the plugin are different objects
+  /// for the same output, so they are matched using the model and position.
+  /// Both are needed, since identical monitors have the same model. (The key
+  /// of the monitor falls back to the model and position if not found)
+  for (auto const &[name, output] : outputs) {
+    if (model == NULL || output.model != model) {
+      continue;
+    }
+
+    if (output.x == geometry.x && output.y == geometry.y) {
+      return output.name;
+    }
+  }
+
+  return "";
+}
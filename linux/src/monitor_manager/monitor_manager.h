@@ -0,0 +1,187 @@
+#pragma once
+
+#include <gtk/gtk.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <flutter_linux/flutter_linux.h>
+#include <wayland-client.h>
+
+namespace FLWM
+{
+    /**
+     * The details of a monitor connected to the display.
+     */
+    struct Monitor
+    {
+        /**
+         * The index of the monitor in the display. This is the index used by setMonitor().
+         */
+        int index;
+
+        /**
+         * The connector name of the monitor. (e.g: DP-1, HDMI-A-1)
+         * Empty if the compositor does not support wl_output version 4.
+         */
+        std::string connector;
+
+        std::string manufacturer;
+
+        std::string model;
+
+        /**
+         * The position and size of the monitor in the logical coordinates.
+         */
+        GdkRectangle geometry;
+
+        /**
+         * The area of the monitor that is not occupied by the exclusive zones of the panels.
+         */
+        GdkRectangle workarea;
+
+        int scaleFactor;
+
+        /**
+         * The refresh rate of the monitor in milli-Hertz. (0 if not known)
+         */
+        int refreshRate;
+
+        /**
+         * The GDK monitor object of this monitor.
+         */
+        GdkMonitor *gdkMonitor;
+    };
+
+    /**
+     * The details of a wl_output that is bound by the plugin. The GDK does not expose the
+     * connector name of the monitors, so the outputs are bound separately to get it.
+     */
+    struct Output
+    {
+        struct wl_output *output;
+
+        std::string name;
+
+        std::string make;
+
+        std::string model;
+
+        int x;
+
+        int y;
+    };
+
+    /**
+     * A callback that is called when the monitors connected to the display are changed.
+     */
+    typedef void (*MonitorsChangedCallback)();
+
+    /**
+     * Keeps a cache of the monitors connected to the display.
+     *
+     * The cache is updated when the monitors are added, removed or changed, and the changes are
+     * delivered to the dart code as "monitorsChanged" events. So the dart code does not need to
+     * poll the monitor list.
+     */
+    class MonitorManager
+    {
+    public:
+        /**
+         * Start tracking the monitors of the given display. Calling this again does nothing.
+         */
+        static void init(GdkDisplay *display);
+
+        /**
+         * Bind a wl_output global advertised by the compositor.
+         */
+        static void bindOutput(struct wl_registry *registry, uint32_t name, uint32_t version);
+
+        /**
+         * Remove a wl_output global that is removed by the compositor.
+         */
+        static void unbindOutput(uint32_t name);
+
+        /**
+         * Returns the list of monitors as "index:model" strings.
+         * The returned value is a new reference.
+         */
+        static FlValue *getMonitorList();
+
+        /**
+         * Returns the list of monitors as maps with the details of each monitor.
+         * The returned value is a new reference.
+         */
+        static FlValue *getMonitors();
+
+        /**
+         * Returns the cached details of all monitors, in the order of the monitor index.
+         */
+        static const std::vector<Monitor> &getMonitorRecords();
+
+        /**
+         * Add a callback that is called after the cache is rebuilt with changed monitors.
+         */
+        static void addListener(MonitorsChangedCallback callback);
+
+    private:
+        static GdkDisplay *display;
+
+        /**
+         * The cached monitor details, in the order of the monitor index.
+         */
+        static std::vector<Monitor> monitors;
+
+        /**
+         * The cached values returned to the dart code.
+         */
+        static FlValue *monitorListValue;
+
+        static FlValue *monitorsValue;
+
+        /**
+         * If the cache needs to be rebuilt.
+         */
+        static bool isDirty;
+
+        /**
+         * The ID of the GSource that rebuilds the cache. (0 if not scheduled)
+         */
+        static guint refreshSourceId;
+
+        /**
+         * The wl_output objects bound by the plugin, mapped with the global name.
+         */
+        static std::map<uint32_t, Output> outputs;
+
+        /**
+         * The callbacks that are called when the monitors are changed.
+         */
+        static std::vector<MonitorsChangedCallback> listeners;
+
+        /**
+         * Mark the cache as dirty and rebuild it in an idle callback. So that the burst of changes
+         * while plugging a monitor is handled once.
+         */
+        static void scheduleRefresh();
+
+        /**
+         * Rebuild the cache if it is dirty, and emit the change event if the monitors are changed.
+         */
+        static void refresh();
+
+        static gboolean onRefresh(gpointer userData);
+
+        static void onMonitorAdded(GdkDisplay *display, GdkMonitor *monitor, gpointer userData);
+
+        static void onMonitorRemoved(GdkDisplay *display, GdkMonitor *monitor, gpointer userData);
+
+        static void onMonitorChanged(GdkMonitor *monitor, GParamSpec *paramSpec, gpointer userData);
+
+        /**
+         * Find the connector name of the given monitor from the outputs bound by the plugin.
+         * (Empty if no output has the same model and position)
+         */
+        static std::string findConnector(GdkMonitor *monitor);
+    };
+}
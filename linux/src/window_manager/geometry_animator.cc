@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <cmath>
+
+#include <event_stream/event_stream.h>
+#include <gtk-layer-shell/gtk-layer-shell.h>
+#include <window_manager/geometry_animator.h>
+#include <window_manager/window_manager.h>
+
+/**
+ * Static member initialization
+ */
+std::map<std::string, FLWM::GeometryAnimation>
+    FLWM::GeometryAnimator::animations;
+
+/**
+ * Get the size of the window. The size request is the size given by setSize().
+ * The allocated size is used if it is not set.
+ */
+void _getSize(GtkWindow *window, int *width, int *height) {
+  gtk_widget_get_size_request(GTK_WIDGET(window), width, height);
+
+  if (*width < 0) {
+    *width = gtk_widget_get_allocated_width(GTK_WIDGET(window));
+  }
+  if (*height < 0) {
+    *height = gtk_widget_get_allocated_height(GTK_WIDGET(window));
+  }
+}
+
+/**
+ * Interpolate between the given optional values. The result is set only if
+ * both are set.
+ */
+std::optional<int> _interpolate(const std::optional<int> &from,
+                                const std::optional<int> &to, double progress) {
+  if (!from.has_value() || !to.has_value()) {
+    return std::nullopt;
+  }
+
+  return (int)std::lround(*from + (*to - *from) * progress);
+}
+
+void FLWM::GeometryAnimator::start(std::string windowId, GtkWindow *window,
+                                   int animationId, WindowGeometry target,
+                                   unsigned int durationMs,
+                                   AnimationCurve curve) {
+  stop(windowId);
+
+  /// The tick callbacks are not called while the window is hidden.
+  if (durationMs == 0 || !gtk_widget_get_mapped(GTK_WIDGET(window))) {
+    applyGeometry(windowId, target);
+    emitEnd(windowId, animationId, true);
+    return;
+  }
+
+  GeometryAnimation animation;
+  animation.windowId = windowId;
+  animation.window = window;
+  animation.animationId = animationId;
+  animation.startTimeUs = 0;
+  animation.durationUs = (gint64)durationMs * 1000;
+  animation.curve = curve;
+  animation.from = getGeometry(windowId, window, target);
+  animation.to = target;
+  animations[windowId] = animation;
+
+  /// The record in the map is used as the user data, since its address does
+  /// not change until it is removed from the map.
+  GeometryAnimation *record = &animations[windowId];
+  record->tickCallbackId =
+      gtk_widget_add_tick_callback(GTK_WIDGET(window), onTick, record, NULL);
+}
+
+void FLWM::GeometryAnimator::stop(std::string windowId) {
+  auto iter = animations.find(windowId);
+  if (iter == animations.end()) {
+    return;
+  }
+
+  gtk_widget_remove_tick_callback(GTK_WIDGET(iter->second.window),
+                                  iter->second.tickCallbackId);
+  finish(windowId, false);
+}
+
+void FLWM::GeometryAnimator::complete(std::string windowId) {
+  auto iter = animations.find(windowId);
+  if (iter == animations.end()) {
+    return;
+  }
+
+  gtk_widget_remove_tick_callback(GTK_WIDGET(iter->second.window),
+                                  iter->second.tickCallbackId);
+  applyGeometry(windowId, iter->second.to);
+  finish(windowId, true);
+}
+
+FLWM::WindowGeometry
+FLWM::GeometryAnimator::getGeometry(std::string windowId, GtkWindow *window,
+                                    const WindowGeometry &target) {
+  WindowGeometry geometry;
+
+  if (target.width.has_value() || target.height.has_value()) {
+    int width, height;
+    _getSize(window, &width, &height);
+    geometry.width = width;
+    geometry.height = height;
+  }
+
+  if (target.marginTop.has_value()) {
+    geometry.marginTop = gtk_layer_get_margin(window, GTK_LAYER_SHELL_EDGE_TOP);
+  }
+  if (target.marginRight.has_value()) {
+    geometry.marginRight =
+        gtk_layer_get_margin(window, GTK_LAYER_SHELL_EDGE_RIGHT);
+  }
+  if (target.marginBottom.has_value()) {
+    geometry.marginBottom =
+        gtk_layer_get_margin(window, GTK_LAYER_SHELL_EDGE_BOTTOM);
+  }
+  if (target.marginLeft.has_value()) {
+    geometry.marginLeft =
+        gtk_layer_get_margin(window, GTK_LAYER_SHELL_EDGE_LEFT);
+  }
+
+  if (target.exclusiveZone.has_value()) {
+    geometry.exclusiveZone =
+        FLWM::WindowManager(windowId).getLayerExclusiveZone();
+  }
+
+  return geometry;
+}
+
+void FLWM::GeometryAnimator::applyGeometry(std::string windowId,
+                                           const WindowGeometry &geometry) {
+  FLWM::WindowManager manager(windowId);
+  GtkWindow *window = manager.getGtkWindow();
+
+  if (geometry.width.has_value() || geometry.height.has_value()) {
+    int width, height;
+    _getSize(window, &width, &height);
+    manager.setSize(geometry.width.value_or(width),
+                    geometry.height.value_or(height));
+  }
+
+  if (geometry.marginTop.has_value()) {
+    gtk_layer_set_margin(window, GTK_LAYER_SHELL_EDGE_TOP, *geometry.marginTop);
+  }
+  if (geometry.marginRight.has_value()) {
+    gtk_layer_set_margin(window, GTK_LAYER_SHELL_EDGE_RIGHT,
+                         *geometry.marginRight);
+  }
+  if (geometry.marginBottom.has_value()) {
+    gtk_layer_set_margin(window, GTK_LAYER_SHELL_EDGE_BOTTOM,
+                         *geometry.marginBottom);
+  }
+  if (geometry.marginLeft.has_value()) {
+    gtk_layer_set_margin(window, GTK_LAYER_SHELL_EDGE_LEFT,
+                         *geometry.marginLeft);
+  }
+
+  if (geometry.exclusiveZone.has_value()) {
+    manager.setLayerExclusiveZone(*geometry.exclusiveZone);
+  }
+}
+
+double FLWM::GeometryAnimator::transform(AnimationCurve curve, double t) {
+  switch (curve) {
+  case CURVE_EASE_IN:
+    return t * t * t;
+  case CURVE_EASE_OUT:
+    return 1 - std::pow(1 - t, 3);
+  case CURVE_EASE_IN_OUT:
+    return t < 0.5 ? 4 * t * t * t : 1 - std::pow(-2 * t + 2, 3) / 2;
+  case CURVE_LINEAR:
+  default:
+    return t;
+  }
+}
+
+void FLWM::GeometryAnimator::finish(std::string windowId, bool completed) {
+  auto iter = animations.find(windowId);
+  int animationId = iter->second.animationId;
+  animations.erase(iter);
+
+  emitEnd(windowId, animationId, completed);
+}
+
+void FLWM::GeometryAnimator::emitEnd(std::string windowId, int animationId,
+                                     bool completed) {
+  FlValue *data = fl_value_new_map();
+  fl_value_set_string_take(data, "animationId", fl_value_new_int(animationId));
+  fl_value_set_string_take(data, "completed", fl_value_new_bool(completed));
+  FLWM::EventStream::emit(windowId, "geometryAnimationEnd", data);
+}
+
+gboolean FLWM::GeometryAnimator::onTick(GtkWidget *widget,
+                                        GdkFrameClock *frameClock,
+                                        gpointer userData) {
+  GeometryAnimation *animation = (GeometryAnimation *)userData;
+  gint64 frameTimeUs = gdk_frame_clock_get_frame_time(frameClock);
+
+  /// The animation starts from the first frame, so that the time spent until
+  /// the first frame is not skipped.
+  if (animation->startTimeUs == 0) {
+    animation->startTimeUs = frameTimeUs;
+  }
+
+  double t = std::clamp(
+      (double)(frameTimeUs - animation->startTimeUs) / animation->durationUs,
+      0.0, 1.0);
+
+  if (t >= 1.0) {
+    applyGeometry(animation->windowId, animation->to);
+
+    /// The record is freed by finish(), so the window ID is copied.
+    std::string windowId = animation->windowId;
+    finish(windowId, true);
+    return G_SOURCE_REMOVE;
+  }
+
+  double progress = transform(animation->curve, t);
+
+  WindowGeometry geometry;
+  geometry.width = _interpolate(animation->from.width, animation->to.width,
+                                progress);
+  geometry.height = _interpolate(animation->from.height, animation->to.height,
+                                 progress);
+  geometry.marginTop = _interpolate(animation->from.marginTop,
+                                    animation->to.marginTop, progress);
+  geometry.marginRight = _interpolate(animation->from.marginRight,
+                                      animation->to.marginRight, progress);
+  geometry.marginBottom = _interpolate(animation->from.marginBottom,
+                                       animation->to.marginBottom, progress);
+  geometry.marginLeft = _interpolate(animation->from.marginLeft,
+                                     animation->to.marginLeft, progress);
+  geometry.exclusiveZone = _interpolate(animation->from.exclusiveZone,
+                                        animation->to.exclusiveZone, progress);
+  applyGeometry(animation->windowId, geometry);
+
+  return G_SOURCE_CONTINUE;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <gtk/gtk.h>
+#include <map>
+#include <optional>
+#include <string>
+
+#include <flutter_linux/flutter_linux.h>
+
+namespace FLWM
+{
+    enum __attribute__((visibility("default"))) AnimationCurve
+    {
+        CURVE_LINEAR = 0,
+        CURVE_EASE_IN,
+        CURVE_EASE_OUT,
+        CURVE_EASE_IN_OUT
+    };
+
+    /**
+     * The geometry of a window that can be animated. The values that are not set are not changed.
+     */
+    struct WindowGeometry
+    {
+        std::optional<int> width;
+
+        std::optional<int> height;
+
+        std::optional<int> marginTop;
+
+        std::optional<int> marginRight;
+
+        std::optional<int> marginBottom;
+
+        std::optional<int> marginLeft;
+
+        std::optional<int> exclusiveZone;
+    };
+
+    /**
+     * A running geometry animation of a window.
+     */
+    struct GeometryAnimation
+    {
+        std::string windowId;
+
+        GtkWindow *window;
+
+        /**
+         * The ID given by the dart code, sent back with the end event. So that the end event of a
+         * stopped animation is not taken as the end of the animation that replaced it.
+         */
+        int animationId;
+
+        /**
+         * The ID of the tick callback added to the window.
+         */
+        guint tickCallbackId;
+
+        /**
+         * The frame time of the first frame of the animation in microseconds.
+         * (0 until the first frame)
+         */
+        gint64 startTimeUs;
+
+        gint64 durationUs;
+
+        AnimationCurve curve;
+
+        /**
+         * The geometry of the window when the animation is started. Only the values set in the
+         * target are used.
+         */
+        WindowGeometry from;
+
+        WindowGeometry to;
+    };
+
+    /**
+     * Animates the size, layer margins and exclusive zone of the windows on the platform side.
+     *
+     * The animation is stepped by the frame clock of the window, which is driven by the wayland
+     * frame callbacks. So each frame of the animation is a single commit of the surface, and the
+     * dart code only sends the target. A "geometryAnimationEnd" event is emitted when the
+     * animation is finished or stopped.
+     */
+    class GeometryAnimator
+    {
+    public:
+        /**
+         * Animate the geometry of the window to the given target. A running animation of the
+         * window is stopped first.
+         *
+         * The target is applied immediately if the window is not shown, since the frame clock
+         * does not run for a hidden window.
+         */
+        static void start(std::string windowId, GtkWindow *window, int animationId,
+                          WindowGeometry target, unsigned int durationMs, AnimationCurve curve);
+
+        /**
+         * Stop the animation of the window at its current geometry.
+         */
+        static void stop(std::string windowId);
+
+        /**
+         * Jump to the target of the animation of the window, and end it. (Used when the window is
+         * hidden, since the frame clock stops and the animation would never end)
+         */
+        static void complete(std::string windowId);
+
+    private:
+        /**
+         * The running animations, mapped with the window IDs.
+         */
+        static std::map<std::string, GeometryAnimation> animations;
+
+        /**
+         * Returns the current geometry of the window, for the values set in the target.
+         */
+        static WindowGeometry getGeometry(std::string windowId, GtkWindow *window,
+                                          const WindowGeometry &target);
+
+        /**
+         * Set the geometry of the window. The values that are not set are not changed.
+         */
+        static void applyGeometry(std::string windowId, const WindowGeometry &geometry);
+
+        /**
+         * Returns the progress of the curve at the given time. (Both are between 0 and 1)
+         */
+        static double transform(AnimationCurve curve, double t);
+
+        /**
+         * Emit the end event of the animation and remove it.
+         */
+        static void finish(std::string windowId, bool completed);
+
+        static void emitEnd(std::string windowId, int animationId, bool completed);
+
+        static gboolean onTick(GtkWidget *widget, GdkFrameClock *frameClock, gpointer userData);
+    };
+}
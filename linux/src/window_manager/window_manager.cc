@@ -1,9 +1,14 @@
-#include <iostream>
+#include <cmath>
 #include <string.h>
 
 #include <gdk/gdkwayland.h>
 #include <gtk-layer-shell/gtk-layer-shell.h>
-#include <protocol_bindings/wlr_layer_shell_protocol_client.h>
+#include <engine/engine_project.h>
+#include <event_stream/event_stream.h>
+#include <frame_telemetry/frame_telemetry.h>
+#include <logger/logger.h>
+#include <monitor_manager/monitor_manager.h>
+#include <window_manager/geometry_animator.h>
 #include <window_manager/window_manager.h>
 
 /**
@@ -11,15 +16,856 @@
  */
 std::map<std::string, FLWM::Window> FLWM::WindowManager::windows;
 wl_compositor *FLWM::WindowManager::compositor = NULL;
+wp_fractional_scale_manager_v1 *FLWM::WindowManager::fractionalScaleManager =
+    NULL;
 
 void _registryHandler(void *data, struct wl_registry *registry, uint32_t id,
                       const char *interface, uint32_t version) {
   if (strcmp(interface, "wl_compositor") == 0) {
     FLWM::WindowManager::compositor = (wl_compositor *)wl_registry_bind(
         registry, id, &wl_compositor_interface, 1);
+  } else if (strcmp(interface, "wl_output") == 0) {
+    FLWM::MonitorManager::bindOutput(registry, id, version);
+  } else if (strcmp(interface, wp_fractional_scale_manager_v1_interface.name) ==
+             0) {
+    FLWM::WindowManager::fractionalScaleManager =
+        (wp_fractional_scale_manager_v1 *)wl_registry_bind(
+            registry, id, &wp_fractional_scale_manager_v1_interface, 1);
+  } else if (strcmp(interface, wp_presentation_interface.name) == 0) {
+    FLWM::FrameTelemetry::bindPresentation(registry, id, version);
   }
 }
 
+/**
+ * Returns the index of the given monitor in the display, or -1 if the monitor
+ * is not connected anymore.
+ */
+int _getMonitorIndex(GdkDisplay *display, GdkMonitor *monitor) {
+  int n_monitors = gdk_display_get_n_monitors(display);
+  for (int i = 0; i < n_monitors; i++) {
+    if (gdk_display_get_monitor(display, i) == monitor) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+/**
+ * This function will try to find the GlArea widget that is internally used to
+ * render the Flutter content from the Flutter engine.alignas
+ *
+ * This widget is required to make the window transparent.
+ */
+GtkWidget *_findGLAreaWidget(GtkWidget *widget) {
+  if (GTK_IS_GL_AREA(widget)) {
+    return widget;
+  }
+
+  if (GTK_IS_CONTAINER(widget)) {
+    GList *children = gtk_container_get_children(GTK_CONTAINER(widget));
+    for (GList *iter = children; iter != NULL; iter = g_list_next(iter)) {
+      GtkWidget *child = GTK_WIDGET(iter->data);
+      GtkWidget *gl_area = _findGLAreaWidget(child);
+      if (gl_area != NULL) {
+        g_list_free(children);
+        return gl_area;
+      }
+    }
+    g_list_free(children);
+  }
+
+  return NULL;
+}
+
+/**
+ * Returns the GL area of the flutter view of the window, resolving it if it is
+ * not cached. (NULL if the window does not have a view yet)
+ */
+GtkWidget *_getGLArea(FLWM::Window *window) {
+  if (window->glArea == NULL && window->view != NULL) {
+    window->glArea = _findGLAreaWidget(GTK_WIDGET(window->view));
+  }
+
+  return window->glArea;
+}
+
+/**
+ * Returns the widget whose realize starts the engine of the view. The engine
+ * is started when the GL area of the view is realized, or the view itself if
+ * it does not have a GL area.
+ */
+GtkWidget *_getEngineWidget(FLWM::Window *window) {
+  GtkWidget *glArea = _getGLArea(window);
+  return glArea != NULL ? glArea : GTK_WIDGET(window->view);
+}
+
+/**
+ * Apply the properties of the window that the engine reads when it is started,
+ * to the shared project and the environment. Returns the shared project.
+ */
+FlDartProject *_prepareEngineStart(FLWM::Window *window) {
+  /// All engines use the same project, so the assets, AOT library and ICU data
+  /// are resolved and mapped once.
+  FlDartProject *project = FLWM::EngineProject::acquire(
+      window->spec.args, window->spec.entrypoint);
+
+  if (!window->isEngineStarting) {
+    window->isEngineStarting = true;
+    window->engineStartResidentBytes = FLWM::EngineProject::getResidentBytes();
+
+    /// The engine reads the switches from the environment when it is started.
+    FLWM::EngineProject::applySwitches(window->spec.engineOptions);
+  }
+
+  return project;
+}
+
+/**
+ * Restore the environment changed by _prepareEngineStart(), if the engine is
+ * not started right away.
+ */
+void _cancelEngineStart(FLWM::Window *window) {
+  if (!window->isEngineStarting) {
+    return;
+  }
+
+  window->isEngineStarting = false;
+  FLWM::EngineProject::resetSwitches();
+}
+
+/**
+ * Called when the view is realized. Its ancestors are realized first, and its
+ * children after it. So this is called right before the GL area starts the
+ * engine, even if another window used the shared project since the view was
+ * created.
+ */
+void _onViewRealize(GtkWidget *widget, gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+
+  if (!window->isEngineRunning) {
+    _prepareEngineStart(window);
+  }
+}
+
+/**
+ * Called after the widget that starts the engine is realized.
+ */
+void _onEngineStarted(GtkWidget *widget, gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+
+  g_signal_handlers_disconnect_by_func(widget, (gpointer)_onEngineStarted,
+                                       userData);
+  window->isEngineRunning = true;
+
+  if (!window->isEngineStarting) {
+    return;
+  }
+  window->isEngineStarting = false;
+
+  FLWM::EngineProject::resetSwitches();
+  FLWM::EngineProject::applyRuntimeOptions(window->view,
+                                           window->spec.engineOptions);
+
+  window->engineResidentBytes = FLWM::EngineProject::getResidentBytes() -
+                                window->engineStartResidentBytes;
+}
+
+/**
+ * Render the GL area of the view with the alpha channel, if the window is
+ * transparent.
+ */
+void _applyGLAreaAlpha(FLWM::Window *window) {
+  if (!window->isTransparent) {
+    return;
+  }
+
+  GtkWidget *glArea = _getGLArea(window);
+  if (glArea != NULL && !gtk_gl_area_get_has_alpha(GTK_GL_AREA(glArea))) {
+    gtk_gl_area_set_has_alpha(GTK_GL_AREA(glArea), TRUE);
+  }
+}
+
+/**
+ * Use the RGBA visual for the window, so that its background can be
+ * transparent. This must be done before the window is realized.
+ */
+void _setTransparentVisual(FLWM::Window *window) {
+  GtkWidget *widget = GTK_WIDGET(window->window);
+  window->isTransparent = true;
+
+  gtk_widget_set_app_paintable(widget, TRUE);
+
+  if (gtk_widget_get_realized(widget)) {
+    FLWM_LOG_DEBUG("The visual of window %s cannot be changed after it is "
+                   "realized. Use the transparent option of createWindow().",
+                   window->id.c_str());
+    return;
+  }
+
+  GdkScreen *screen = gtk_widget_get_screen(widget);
+  GdkVisual *visual = gdk_screen_get_rgba_visual(screen);
+  if (visual != NULL && gdk_screen_is_composited(screen)) {
+    gtk_widget_set_visual(widget, visual);
+  }
+}
+
+/**
+ * Returns the wayland surface of the window, resolving it if it is not cached.
+ * (NULL if the window is not shown)
+ */
+struct wl_surface *_getWlSurface(FLWM::Window *window) {
+  if (window->wlSurface == NULL &&
+      gtk_widget_get_mapped(GTK_WIDGET(window->window))) {
+    GdkWindow *gdkWindow = gtk_widget_get_window(GTK_WIDGET(window->window));
+    window->wlSurface = gdk_wayland_window_get_wl_surface(gdkWindow);
+  }
+
+  return window->wlSurface;
+}
+
+/**
+ * Returns the messenger of the engine of the window. (NULL if the window does
+ * not have a view yet)
+ */
+FlBinaryMessenger *_getMessenger(FLWM::Window *window) {
+  if (window->view == NULL) {
+    return NULL;
+  }
+
+  /// The registrar is released here, but the messenger is owned by the engine.
+  FLWM::GObjectRef<FlPluginRegistrar> registrar(
+      fl_plugin_registry_get_registrar_for_plugin(
+          FL_PLUGIN_REGISTRY(window->view), "FlLinuxWindowManagerPlugin"));
+  return fl_plugin_registrar_get_messenger(registrar);
+}
+
+/**
+ * Send a message to the engine of the window on a channel that is handled by
+ * the flutter framework itself.
+ */
+void _sendSystemMessage(FLWM::Window *window, const char *channelName,
+                        FlMessageCodec *codec, FlValue *message) {
+  FlBinaryMessenger *messenger = _getMessenger(window);
+  if (messenger == NULL) {
+    return;
+  }
+
+  FLWM::GObjectRef<FlBasicMessageChannel> channel(
+      fl_basic_message_channel_new(messenger, channelName, codec));
+  fl_basic_message_channel_send(channel, message, NULL, NULL, NULL);
+}
+
+/**
+ * Send the given app lifecycle state to the engine of the window.
+ * (e.g: "AppLifecycleState.paused")
+ *
+ * The framework stops scheduling frames while the state is hidden or paused,
+ * and goes through the states in between by itself.
+ */
+void _sendLifecycleState(FLWM::Window *window, const char *state) {
+  FLWM::GObjectRef<FlStringCodec> codec(fl_string_codec_new());
+  FLWM::FlValueRef message(fl_value_new_string(state));
+
+  _sendSystemMessage(window, "flutter/lifecycle", FL_MESSAGE_CODEC(codec.get()),
+                     message);
+}
+
+/**
+ * Tell the engine of the window that the memory is low, so that the framework
+ * releases its caches. (e.g: The image cache)
+ */
+void _sendMemoryPressure(FLWM::Window *window) {
+  FLWM::GObjectRef<FlJsonMessageCodec> codec(fl_json_message_codec_new());
+  FLWM::FlValueRef message(fl_value_new_map());
+  fl_value_set_string_take(message, "type",
+                           fl_value_new_string("memoryPressure"));
+
+  _sendSystemMessage(window, "flutter/system", FL_MESSAGE_CODEC(codec.get()),
+                     message);
+}
+
+/**
+ * Emit a monitor enter/leave event with the given monitor.
+ */
+void _emitMonitorEvent(FLWM::Window *window, const char *name,
+                       GdkMonitor *monitor) {
+  GdkDisplay *display = gtk_widget_get_display(GTK_WIDGET(window->window));
+
+  FlValue *data = fl_value_new_map();
+  fl_value_set_string_take(
+      data, "monitor", fl_value_new_int(_getMonitorIndex(display, monitor)));
+  FLWM::EventStream::emit(window->id, name, data);
+}
+
+/**
+ * Check the monitor on which the window is currently shown, and emit the
+ * monitor leave/enter events if it is changed.
+ *
+ * GTK3 does not expose the wl_surface enter/leave events of the window, so the
+ * monitor is checked whenever the window is mapped or configured.
+ */
+void _updateMonitor(FLWM::Window *window) {
+  GdkWindow *gdkWindow = gtk_widget_get_window(GTK_WIDGET(window->window));
+  GdkMonitor *monitor = NULL;
+
+  if (gdkWindow != NULL && gtk_widget_get_mapped(GTK_WIDGET(window->window))) {
+    monitor = gdk_display_get_monitor_at_window(
+        gdk_window_get_display(gdkWindow), gdkWindow);
+  }
+
+  if (monitor == window->monitor) {
+    return;
+  }
+
+  if (window->monitor != NULL) {
+    _emitMonitorEvent(window, "monitorLeave", window->monitor);
+  }
+
+  if (monitor != NULL) {
+    _emitMonitorEvent(window, "monitorEnter", monitor);
+  }
+
+  window->monitor = monitor;
+}
+
+/**
+ * Called when the compositor configures the window with a new size. For the
+ * layer windows, this is the size given by the layer surface configure.
+ */
+gboolean _onConfigureEvent(GtkWidget *widget, GdkEventConfigure *event,
+                           gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+
+  FlValue *data = fl_value_new_map();
+  fl_value_set_string_take(data, "x", fl_value_new_int(event->x));
+  fl_value_set_string_take(data, "y", fl_value_new_int(event->y));
+  fl_value_set_string_take(data, "width", fl_value_new_int(event->width));
+  fl_value_set_string_take(data, "height", fl_value_new_int(event->height));
+  FLWM::EventStream::emit(window->id, "configure", data);
+
+  _updateMonitor(window);
+
+  return FALSE;
+}
+
+/**
+ * Emit a scale change event with the current scale of the window.
+ */
+void _emitScaleEvent(FLWM::Window *window) {
+  FLWM::EventStream::emit(window->id, "scaleChanged",
+                          FLWM::WindowManager(window->id).getScale());
+}
+
+void _onPreferredScale(void *data,
+                       struct wp_fractional_scale_v1 *fractionalScale,
+                       uint32_t scale) {
+  FLWM::Window *window = (FLWM::Window *)data;
+
+  /// The scale is sent as the numerator of a fraction with a denominator of
+  /// 120. (e.g: 150 for 1.25)
+  double preferredScale = scale / 120.0;
+  if (preferredScale == window->preferredScale) {
+    return;
+  }
+
+  window->preferredScale = preferredScale;
+  _emitScaleEvent(window);
+}
+
+/**
+ * Start listening to the preferred scale of the window surface.
+ */
+void _attachFractionalScale(FLWM::Window *window) {
+  if (FLWM::WindowManager::fractionalScaleManager == NULL ||
+      window->fractionalScale.get() != NULL) {
+    return;
+  }
+
+  struct wl_surface *wlSurface = _getWlSurface(window);
+  if (wlSurface == NULL) {
+    return;
+  }
+
+  static const struct wp_fractional_scale_v1_listener fractionalScaleListener =
+      {
+          .preferred_scale = _onPreferredScale,
+      };
+
+  window->fractionalScale.reset(
+      wp_fractional_scale_manager_v1_get_fractional_scale(
+          FLWM::WindowManager::fractionalScaleManager, wlSurface));
+  wp_fractional_scale_v1_add_listener(window->fractionalScale.get(),
+                                      &fractionalScaleListener, window);
+}
+
+void _detachFractionalScale(FLWM::Window *window) {
+  window->fractionalScale.reset();
+}
+
+/**
+ * Returns the monitor with the given index. (NULL if there is no such monitor)
+ */
+GdkMonitor *_getMonitor(GtkWidget *widget, int index) {
+  GdkDisplay *display = gtk_widget_get_display(widget);
+  if (index < 0 || index >= gdk_display_get_n_monitors(display)) {
+    return NULL;
+  }
+
+  return gdk_display_get_monitor(display, index);
+}
+
+/**
+ * End the move of the window to another monitor, and remove its placeholder.
+ */
+void _finishMigration(FLWM::Window *window, bool completed) {
+  if (window->migrationStage == FLWM::MIGRATION_NONE) {
+    return;
+  }
+
+  if (window->migrationSourceId != 0) {
+    g_source_remove(window->migrationSourceId);
+    window->migrationSourceId = 0;
+  }
+
+  if (window->migrationPlaceholder != NULL) {
+    g_signal_handlers_disconnect_by_data(window->migrationPlaceholder, window);
+    gtk_widget_destroy(window->migrationPlaceholder);
+    window->migrationPlaceholder = NULL;
+  }
+
+  int monitor = window->migrationMonitor;
+  window->migrationStage = FLWM::MIGRATION_NONE;
+  window->migrationMonitor = -1;
+
+  FlValue *data = fl_value_new_map();
+  fl_value_set_string_take(data, "monitor", fl_value_new_int(monitor));
+  fl_value_set_string_take(data, "completed", fl_value_new_bool(completed));
+  FLWM::EventStream::emit(window->id, "monitorMigrated", data);
+}
+
+/**
+ * Called after the window is drawn on the target monitor for the first time.
+ * The window has taken the place of the placeholder there.
+ */
+gboolean _onMigratedWindowDrawn(gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+  window->migrationSourceId = 0;
+
+  _finishMigration(window, true);
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * Called after the placeholder is drawn on the target monitor for the first
+ * time. The compositor configured it, and made room for it on the monitor.
+ */
+gboolean _onPlaceholderShown(gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+  window->migrationSourceId = 0;
+
+  GtkWidget *widget = GTK_WIDGET(window->window);
+  GdkMonitor *monitor = _getMonitor(widget, window->migrationMonitor);
+  if (monitor == NULL) {
+    _finishMigration(window, false);
+    return G_SOURCE_REMOVE;
+  }
+
+  /// The library remaps a shown window to move it to another monitor.
+  window->migrationStage = FLWM::MIGRATION_REMAPPING;
+  gtk_layer_set_monitor(window->window, monitor);
+
+  if (!gtk_widget_get_mapped(widget)) {
+    _finishMigration(window, false);
+    return G_SOURCE_REMOVE;
+  }
+
+  window->migrationStage = FLWM::MIGRATION_SWAPPING;
+  gtk_widget_queue_draw(widget);
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * Keep the placeholder fully transparent.
+ */
+gboolean _onPlaceholderDraw(GtkWidget *widget, cairo_t *cairo,
+                            gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+
+  cairo_set_operator(cairo, CAIRO_OPERATOR_CLEAR);
+  cairo_paint(cairo);
+
+  /// The window is moved after this frame is committed.
+  if (window->migrationStage == FLWM::MIGRATION_STAGING &&
+      window->migrationSourceId == 0) {
+    window->migrationSourceId = g_idle_add(_onPlaceholderShown, window);
+  }
+
+  return TRUE;
+}
+
+/**
+ * Create an empty layer window on the given monitor, with the layer state of
+ * the given window. It does not take any input.
+ */
+GtkWidget *_createPlaceholder(FLWM::Window *window, GdkMonitor *monitor) {
+  GtkWindow *source = window->window;
+  GtkWidget *widget = gtk_window_new(GTK_WINDOW_TOPLEVEL);
+  GtkWindow *placeholder = GTK_WINDOW(widget);
+
+  gtk_layer_init_for_window(placeholder);
+  gtk_layer_set_layer(placeholder, gtk_layer_get_layer(source));
+  gtk_layer_set_namespace(placeholder, gtk_layer_get_namespace(source));
+  gtk_layer_set_keyboard_mode(placeholder,
+                              GTK_LAYER_SHELL_KEYBOARD_MODE_NONE);
+  gtk_layer_set_monitor(placeholder, monitor);
+
+  static const GtkLayerShellEdge edges[] = {
+      GTK_LAYER_SHELL_EDGE_TOP, GTK_LAYER_SHELL_EDGE_RIGHT,
+      GTK_LAYER_SHELL_EDGE_BOTTOM, GTK_LAYER_SHELL_EDGE_LEFT};
+  for (GtkLayerShellEdge edge : edges) {
+    gtk_layer_set_anchor(placeholder, edge, gtk_layer_get_anchor(source, edge));
+    gtk_layer_set_margin(placeholder, edge, gtk_layer_get_margin(source, edge));
+  }
+
+  if (gtk_layer_auto_exclusive_zone_is_enabled(source)) {
+    gtk_layer_auto_exclusive_zone_enable(placeholder);
+  } else {
+    gtk_layer_set_exclusive_zone(placeholder, window->exclusiveZone);
+  }
+
+  /// The placeholder gets the size of the window on the target monitor.
+  int width, height;
+  gtk_widget_get_size_request(GTK_WIDGET(source), &width, &height);
+  gtk_widget_set_size_request(widget, width, height);
+
+  GdkScreen *screen = gtk_widget_get_screen(widget);
+  GdkVisual *visual = gdk_screen_get_rgba_visual(screen);
+  if (visual != NULL) {
+    gtk_widget_set_visual(widget, visual);
+  }
+  gtk_widget_set_app_paintable(widget, TRUE);
+
+  cairo_region_t *inputRegion = cairo_region_create();
+  gtk_widget_input_shape_combine_region(widget, inputRegion);
+  cairo_region_destroy(inputRegion);
+
+  g_signal_connect(widget, "draw", G_CALLBACK(_onPlaceholderDraw), window);
+  gtk_widget_show(widget);
+
+  return widget;
+}
+
+/**
+ * Set the opaque region of the window to its surface.
+ */
+void _applyOpaqueRegion(FLWM::Window *window, struct wl_surface *wlSurface) {
+  /// GDK sends its own opaque region when GTK changes it (e.g: When the window
+  /// is resized), so it is kept the same as the region of the plugin.
+  /// A soft hidden window draws nothing, so none of it is opaque.
+  cairo_region_t *opaqueRegion =
+      window->isSoftHidden ? NULL : window->opaqueRegion.get();
+
+  GdkWindow *gdkWindow = gtk_widget_get_window(GTK_WIDGET(window->window));
+  if (gdkWindow != NULL) {
+    gdk_window_set_opaque_region(gdkWindow, opaqueRegion);
+  }
+
+  /// GDK sends it only with a drawn frame, so it is also set to the surface.
+  FLWM::WlProxy<wl_region, WL_REGION_DESTROY> region;
+  if (opaqueRegion != NULL) {
+    region.reset(wl_compositor_create_region(FLWM::WindowManager::compositor));
+
+    int count = cairo_region_num_rectangles(opaqueRegion);
+    for (int i = 0; i < count; i++) {
+      cairo_rectangle_int_t rect;
+      cairo_region_get_rectangle(opaqueRegion, i, &rect);
+      wl_region_add(region, rect.x, rect.y, rect.width, rect.height);
+    }
+  }
+
+  /// The surface copies the region, so it is destroyed right after.
+  wl_surface_set_opaque_region(wlSurface, region);
+}
+
+/**
+ * Set the pending state to the window surface. It is double buffered, so it
+ * takes effect with the next commit of the surface.
+ */
+void _applySurfaceState(FLWM::Window *window) {
+  struct wl_surface *wlSurface = _getWlSurface(window);
+  if (wlSurface == NULL) {
+    return;
+  }
+
+  if (window->pendingSurfaceState & FLWM::SURFACE_STATE_INPUT_REGION) {
+    if (window->isSoftHidden) {
+      /// An empty region takes no input. The surface copies the region, so it
+      /// is destroyed right after.
+      FLWM::WlProxy<wl_region, WL_REGION_DESTROY> emptyRegion;
+      emptyRegion.reset(
+          wl_compositor_create_region(FLWM::WindowManager::compositor));
+      wl_surface_set_input_region(wlSurface, emptyRegion);
+    } else {
+      /// A NULL region is the infinite input region.
+      wl_surface_set_input_region(wlSurface, window->inputRegion.get());
+    }
+  }
+
+  if (window->pendingSurfaceState & FLWM::SURFACE_STATE_OPAQUE_REGION) {
+    _applyOpaqueRegion(window, wlSurface);
+  }
+
+  window->pendingSurfaceState = 0;
+  window->isAwaitingCommit = true;
+}
+
+void _onBeforePaint(GdkFrameClock *frameClock, gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+
+  window->isFrameDrawn = false;
+  if (window->pendingSurfaceState != 0) {
+    _applySurfaceState(window);
+  }
+}
+
+/**
+ * Called when the window is drawn in the paint phase of a frame.
+ */
+gboolean _onDraw(GtkWidget *widget, cairo_t *cairo, gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+  window->isFrameDrawn = true;
+
+  if (window->migrationStage == FLWM::MIGRATION_SWAPPING &&
+      window->migrationSourceId == 0) {
+    window->migrationSourceId = g_idle_add(_onMigratedWindowDrawn, window);
+  }
+
+  return FALSE;
+}
+
+void _onAfterPaint(GdkFrameClock *frameClock, gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+
+  if (!window->isAwaitingCommit) {
+    return;
+  }
+  window->isAwaitingCommit = false;
+
+  /// The state is committed by GDK along with the drawn frame. The frame is
+  /// not drawn if the flutter view did not change, so it is committed here.
+  struct wl_surface *wlSurface = _getWlSurface(window);
+  if (!window->isFrameDrawn && wlSurface != NULL) {
+    wl_surface_commit(wlSurface);
+  }
+}
+
+void _detachFrameClock(FLWM::Window *window) {
+  if (window->frameClock != NULL) {
+    g_signal_handlers_disconnect_by_data(window->frameClock, window);
+    window->frameClock = NULL;
+  }
+  window->isAwaitingCommit = false;
+}
+
+void _attachFrameClock(FLWM::Window *window) {
+  GdkFrameClock *frameClock =
+      gtk_widget_get_frame_clock(GTK_WIDGET(window->window));
+  if (frameClock == window->frameClock) {
+    return;
+  }
+
+  _detachFrameClock(window);
+  if (frameClock == NULL) {
+    return;
+  }
+
+  window->frameClock = frameClock;
+  g_signal_connect(frameClock, "before-paint", G_CALLBACK(_onBeforePaint),
+                   window);
+  g_signal_connect(frameClock, "after-paint", G_CALLBACK(_onAfterPaint),
+                   window);
+}
+
+/**
+ * Mark the given state of the window surface as changed. It is applied with
+ * the next frame of the window, so that it takes effect along with the frame
+ * drawn for it, and the changes in the same frame are committed once.
+ */
+void _queueSurfaceState(FLWM::Window *window, unsigned int state) {
+  window->pendingSurfaceState |= state;
+
+  /// The state of a hidden window is applied when it is shown.
+  if (!gtk_widget_get_mapped(GTK_WIDGET(window->window))) {
+    return;
+  }
+
+  _attachFrameClock(window);
+  if (window->frameClock != NULL) {
+    gdk_frame_clock_request_phase(window->frameClock,
+                                  GDK_FRAME_CLOCK_PHASE_PAINT);
+  }
+}
+
+/**
+ * Called after GTK allocated the size of the window. GTK resets the opaque
+ * region of the GDK window, so it is applied again.
+ */
+void _onSizeAllocate(GtkWidget *widget, GdkRectangle *allocation,
+                     gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+
+  if (window->opaqueRegion.get() != NULL) {
+    _queueSurfaceState(window, FLWM::SURFACE_STATE_OPAQUE_REGION);
+  }
+}
+
+void _onMap(GtkWidget *widget, gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+
+  /// GDK creates a new wl_surface every time the window is shown.
+  window->wlSurface = NULL;
+  _attachFractionalScale(window);
+
+  /// The regions of the old surface are not applied to the new one.
+  if (window->inputRegion.get() != NULL || window->isSoftHidden) {
+    window->pendingSurfaceState |= FLWM::SURFACE_STATE_INPUT_REGION;
+  }
+  if (window->opaqueRegion.get() != NULL) {
+    window->pendingSurfaceState |= FLWM::SURFACE_STATE_OPAQUE_REGION;
+  }
+  if (window->pendingSurfaceState != 0) {
+    _queueSurfaceState(window, window->pendingSurfaceState);
+  }
+
+  /// The engine is not paused while the window is moved to another monitor.
+  if (window->migrationStage != FLWM::MIGRATION_REMAPPING) {
+    _sendLifecycleState(window, "AppLifecycleState.resumed");
+  }
+
+  FLWM::EventStream::emit(window->id, "map");
+  _updateMonitor(window);
+}
+
+void _onUnmap(GtkWidget *widget, gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+
+  _detachFractionalScale(window);
+  window->wlSurface = NULL;
+
+  /// The frame clock of a hidden window does not tick, so a running animation
+  /// jumps to its target.
+  FLWM::GeometryAnimator::complete(window->id);
+
+  /// A hidden window does not draw, so its engine does not need to run its
+  /// animations and frame callbacks. It is shown again right away if it is
+  /// moved to another monitor.
+  if (window->migrationStage != FLWM::MIGRATION_REMAPPING) {
+    _sendLifecycleState(window, "AppLifecycleState.paused");
+
+    /// The move is cancelled if the window is hidden.
+    _finishMigration(window, false);
+  }
+
+  FLWM::EventStream::emit(window->id, "unmap");
+  _updateMonitor(window);
+}
+
+/**
+ * Called when the integer scale used by GDK for the window buffers is changed.
+ */
+void _onScaleFactorChanged(GObject *object, GParamSpec *paramSpec,
+                           gpointer userData) {
+  _emitScaleEvent((FLWM::Window *)userData);
+}
+
+/**
+ * Called when the window is realized or unrealized. The GL area of the view is
+ * recreated along with the window resources.
+ */
+void _onRealizeChanged(GtkWidget *widget, gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+
+  window->glArea = NULL;
+  window->wlSurface = NULL;
+
+  /// The frame clock belongs to the GDK window, which is recreated.
+  _detachFrameClock(window);
+}
+
+void _onChildAdded(GtkContainer *container, GtkWidget *child,
+                   gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+
+  if (FL_IS_VIEW(child)) {
+    window->view = FL_VIEW(child);
+    window->glArea = NULL;
+  }
+}
+
+void _onChildRemoved(GtkContainer *container, GtkWidget *child,
+                     gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+
+  if (child == GTK_WIDGET(window->view)) {
+    window->view = NULL;
+    window->glArea = NULL;
+  }
+}
+
+gboolean _onFocusIn(GtkWidget *widget, GdkEventFocus *event,
+                    gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+  FLWM::EventStream::emit(window->id, "focusIn");
+
+  return FALSE;
+}
+
+gboolean _onFocusOut(GtkWidget *widget, GdkEventFocus *event,
+                     gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+  FLWM::EventStream::emit(window->id, "focusOut");
+
+  return FALSE;
+}
+
+/**
+ * Called when the window is destroyed without calling closeWindow(). (e.g: The
+ * user closed the window using the title bar)
+ */
+void _onDestroy(GtkWidget *widget, gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+  std::string id = window->id;
+
+  FLWM::WindowManager::removeWindow(id);
+  FLWM::EventStream::emit(id, "closed");
+}
+
+/**
+ * Connect the signals of the GTK window that are delivered as events to the
+ * dart code.
+ */
+void _connectWindowSignals(FLWM::Window *window) {
+  GtkWidget *widget = GTK_WIDGET(window->window);
+
+  g_signal_connect(widget, "configure-event", G_CALLBACK(_onConfigureEvent),
+                   window);
+  g_signal_connect(widget, "map", G_CALLBACK(_onMap), window);
+  g_signal_connect(widget, "unmap", G_CALLBACK(_onUnmap), window);
+  g_signal_connect(widget, "focus-in-event", G_CALLBACK(_onFocusIn), window);
+  g_signal_connect(widget, "focus-out-event", G_CALLBACK(_onFocusOut), window);
+  g_signal_connect(widget, "destroy", G_CALLBACK(_onDestroy), window);
+  g_signal_connect(widget, "notify::scale-factor",
+                   G_CALLBACK(_onScaleFactorChanged), window);
+  g_signal_connect(widget, "realize", G_CALLBACK(_onRealizeChanged), window);
+  g_signal_connect(widget, "unrealize", G_CALLBACK(_onRealizeChanged), window);
+  g_signal_connect(widget, "add", G_CALLBACK(_onChildAdded), window);
+  g_signal_connect(widget, "remove", G_CALLBACK(_onChildRemoved), window);
+  g_signal_connect(widget, "draw", G_CALLBACK(_onDraw), window);
+  g_signal_connect_after(widget, "size-allocate", G_CALLBACK(_onSizeAllocate),
+                         window);
+}
+
 void FLWM::WindowManager::addWindow(GtkWindow *window, std::string id) {
   /// Initialize the wayland objects.
   if (FLWM::WindowManager::compositor == NULL) {
@@ -31,12 +877,18 @@ void FLWM::WindowManager::addWindow(GtkWindow *window, std::string id) {
     struct wl_registry *registry = wl_display_get_registry(wl_display);
     static const struct wl_registry_listener registry_listener = {
         .global = _registryHandler,
-        .global_remove = [](void *data, struct wl_registry *registry,
-                            uint32_t name) {},
+        .global_remove =
+            [](void *data, struct wl_registry *registry, uint32_t name) {
+              FLWM::MonitorManager::unbindOutput(name);
+            },
     };
     wl_registry_add_listener(registry, &registry_listener, NULL);
     /// Wait for fetching the registry data binding.
     wl_display_roundtrip(wl_display);
+
+    /// Start tracking the monitors, so that the monitor list is not fetched
+    /// from GDK on every call.
+    FLWM::MonitorManager::init(gdk_display);
   }
 
   /// Check if the window is already added to the list of windows.
@@ -48,17 +900,124 @@ void FLWM::WindowManager::addWindow(GtkWindow *window, std::string id) {
   Window newWindow;
   newWindow.id = id;
   newWindow.window = window;
-  newWindow.methodChannels = std::map<std::string, FlMethodChannel *>();
-  newWindow.inputRegion = NULL;
+  newWindow.glArea = NULL;
+  newWindow.wlSurface = NULL;
+  newWindow.monitor = NULL;
+  newWindow.preferredScale = 0;
+  newWindow.exclusiveZone = 0;
+  newWindow.engineStartSourceId = 0;
+  newWindow.engineResidentBytes = 0;
+  newWindow.evictable = false;
+  newWindow.pendingSurfaceState = 0;
+  newWindow.frameClock = NULL;
+  newWindow.isAwaitingCommit = false;
+  newWindow.isFrameDrawn = false;
+  newWindow.isTransparent = false;
+  newWindow.isSoftHidden = false;
+  newWindow.softHiddenKeyboardMode = FLWM::KeyboardInteractivity::NONE;
+  newWindow.softHiddenAutoExclusiveZone = false;
+  newWindow.migrationStage = FLWM::MIGRATION_NONE;
+  newWindow.migrationPlaceholder = NULL;
+  newWindow.migrationMonitor = -1;
+  newWindow.migrationSourceId = 0;
+
+  /// The main window already has its view when it is added. The views of the
+  /// other windows are tracked with the "add" signal.
+  GtkWidget *child = gtk_bin_get_child(GTK_BIN(window));
+  newWindow.view = child != NULL && FL_IS_VIEW(child) ? FL_VIEW(child) : NULL;
+
+  /// The main window is created with its engine.
+  newWindow.isEngineStarted = newWindow.view != NULL;
+  newWindow.isEngineRunning = newWindow.isEngineStarted;
+  newWindow.isEngineStarting = false;
+  newWindow.engineStartResidentBytes = 0;
+
+  windows[id] = std::move(newWindow);
+
+  /// Listen to the window signals, to deliver them as events to the dart code.
+  /// The record in the map is used as the user data, since its address does not
+  /// change until it is removed from the map.
+  _connectWindowSignals(&windows[id]);
+
+  /// The main window is already shown when it is added.
+  if (gtk_widget_get_mapped(GTK_WIDGET(window))) {
+    _attachFractionalScale(&windows[id]);
+  }
+}
+
+void FLWM::WindowManager::removeWindow(std::string id) {
+  auto iter = windows.find(id);
+  if (iter == windows.end()) {
+    return;
+  }
+
+  Window *record = &(iter->second);
+
+  /// Stop listening to the window signals, since the record is going to be
+  /// freed.
+  if (record->window != NULL) {
+    g_signal_handlers_disconnect_by_data(record->window, record);
+  }
+  if (record->view != NULL) {
+    g_signal_handlers_disconnect_by_data(record->view, record);
+    g_signal_handlers_disconnect_by_data(_getEngineWidget(record), record);
+  }
+  _cancelEngineStart(record);
+
+  /// Destroy the input region if it is not NULL
+  record->inputRegion.reset();
+  record->opaqueRegion.reset();
+
+  _detachFractionalScale(record);
+  _detachFrameClock(record);
+
+  FLWM::FrameTelemetry::disable(id);
+
+  /// The end event of a running animation is emitted, so that the dart code
+  /// waiting for it does not wait forever.
+  FLWM::GeometryAnimator::stop(id);
+  _finishMigration(record, false);
+
+  if (record->engineStartSourceId != 0) {
+    g_source_remove(record->engineStartSourceId);
+  }
+
+  /// Clear the method channels for this window
+  for (auto const &[key, val] : record->methodChannels) {
+    fl_method_channel_set_method_call_handler(val, NULL, NULL, NULL);
+  }
+  record->methodChannels.clear();
+
+  FLWM::EventStream::detach(id);
+
+  windows.erase(iter);
+}
+
+std::string FLWM::WindowManager::getWindowId(GtkWindow *window) {
+  for (auto const &[id, record] : windows) {
+    if (record.window == window) {
+      return id;
+    }
+  }
+
+  return "";
+}
 
-  windows[id] = newWindow;
+std::vector<std::string> FLWM::WindowManager::getWindowIds() {
+  std::vector<std::string> ids;
+  for (auto const &[id, record] : windows) {
+    ids.push_back(id);
+  }
+
+  return ids;
 }
 
 FLWM::WindowManager::WindowManager(std::string id) {
   if (windows.find(id) != windows.end()) {
     this->window = &(windows[id]);
   } else {
-    std::cerr << "The window with the given ID is not found!" << std::endl;
+    FLWM_LOG_WARNING("The window with the given ID is not found: %s",
+                     id.c_str());
     this->window = NULL;
   }
 }
@@ -82,157 +1041,262 @@ void FLWM::WindowManager::setSize(unsigned int width, unsigned int height) {
   /// Only If the view is already present in the window.
   /// For new windows, the FL_VIEW may not be attached as child, so this step
   /// will be skipped.
-  GList *children = gtk_container_get_children(GTK_CONTAINER(window->window));
-  for (GList *iter = children; iter != nullptr; iter = iter->next) {
-    GtkWidget *child = GTK_WIDGET(iter->data);
+  if (window->view != NULL) {
+    gtk_widget_set_size_request(GTK_WIDGET(window->view), width, height);
+  }
+}
 
-    if (FL_IS_VIEW(child)) {
-      gtk_widget_set_size_request(GTK_WIDGET(child), width, height);
-    }
+void FLWM::WindowManager::enableTransparency() {
+  /// The GL area of a view that is not added yet is set when the engine is
+  /// started.
+  _setTransparentVisual(window);
+  _applyGLAreaAlpha(window);
+}
+
+void FLWM::WindowManager::setTitle(std::string title) {
+  /// The namespace is not changed with the title, since changing it remaps the
+  /// layer surface.
+  gtk_window_set_title(window->window, title.c_str());
+}
+
+void FLWM::WindowManager::setLayerNamespace(std::string layerNamespace) {
+  if (!gtk_layer_is_layer_window(window->window)) {
+    FLWM_LOG_WARNING("Cannot set the namespace of window %s, since it is not "
+                     "a layer window.",
+                     window->id.c_str());
+    return;
   }
-  g_list_free(children);
+
+  gtk_layer_set_namespace(window->window, layerNamespace.c_str());
+}
+
+void FLWM::WindowManager::setIsDecorated(bool isDecorated) {
+  gtk_window_set_decorated(window->window, isDecorated);
+}
+
+FlValue *FLWM::WindowManager::isWindowIdUsed(std::string id) {
+  return fl_value_new_bool(hasWindow(id));
+}
+
+bool FLWM::WindowManager::hasWindow(std::string id) {
+  return windows.find(id) != windows.end();
 }
 
 /**
- * This function will try to find the GlArea widget that is internally used to
- * render the Flutter content from the Flutter engine.alignas
- *
- * This widget is required to make the window transparent.
+ * Create the flutter view of the window with the properties of the window, and
+ * start its engine.
  */
-GtkWidget *_findGLAreaWidget(GtkWidget *widget) {
-  if (GTK_IS_GL_AREA(widget)) {
-    return widget;
+void _startEngine(FLWM::Window *window) {
+  if (window->isEngineStarted || window->spec.isNative) {
+    return;
   }
+  window->isEngineStarted = true;
 
-  if (GTK_IS_CONTAINER(widget)) {
-    GList *children = gtk_container_get_children(GTK_CONTAINER(widget));
-    for (GList *iter = children; iter != NULL; iter = g_list_next(iter)) {
-      GtkWidget *child = GTK_WIDGET(iter->data);
-      GtkWidget *gl_area = _findGLAreaWidget(child);
-      if (gl_area != NULL) {
-        g_list_free(children);
-        return gl_area;
-      }
-    }
-    g_list_free(children);
+  if (window->engineStartSourceId != 0) {
+    g_source_remove(window->engineStartSourceId);
+    window->engineStartSourceId = 0;
   }
 
-  return NULL;
-}
+  /// They are applied again when the view is realized, if the engine is not
+  /// started below.
+  FlDartProject *project = _prepareEngineStart(window);
 
-void FLWM::WindowManager::enableTransparency() {
-  GtkWidget *firstChild = GTK_WIDGET(
-      gtk_container_get_children(GTK_CONTAINER(window->window))->data);
+  FlView *view = fl_view_new(project);
+  g_signal_connect(view, "realize", G_CALLBACK(_onViewRealize), window);
+  gtk_widget_show(GTK_WIDGET(view));
+  gtk_container_add(GTK_CONTAINER(window->window), GTK_WIDGET(view));
 
-  /// Enable alpha channel for the GLArea widget.
-  GtkWidget *glAreaWidget = _findGLAreaWidget(GTK_WIDGET(firstChild));
-  if (glAreaWidget != NULL) {
-    gtk_gl_area_set_has_alpha(GTK_GL_AREA(glAreaWidget), TRUE);
-  }
+  /// The alpha is set before the GL area allocates its buffers, if the view
+  /// creates it before being realized.
+  _applyGLAreaAlpha(window);
 
-  /// Make the window transparent.
-  gtk_widget_set_app_paintable(GTK_WIDGET(window->window), TRUE);
-  GdkScreen *gtkScreen = gdk_screen_get_default();
-  GdkVisual *visual = gdk_screen_get_rgba_visual(gtkScreen);
+  /// setSize() skips the view while it is not added.
+  int width, height;
+  gtk_widget_get_size_request(GTK_WIDGET(window->window), &width, &height);
+  gtk_widget_set_size_request(GTK_WIDGET(view), width, height);
 
-  if (visual != NULL && gdk_screen_is_composited(gtkScreen)) {
-    gtk_widget_set_visual(GTK_WIDGET(window->window), visual);
+  /// Register the plugins for the flutter application, to the new flutter
+  /// view/engine
+  fl_register_plugins(FL_PLUGIN_REGISTRY(view));
+
+  /// The engine is started when the GL area of the view is realized, and it
+  /// reads the entrypoint arguments of the shared project at that time. So the
+  /// GL area is realized right away, before the project is used by another
+  /// window. A hidden window does not realize its children by itself, and
+  /// realizing a widget only realizes its ancestors, not its children.
+  GtkWidget *engineWidget = _getEngineWidget(window);
+  g_signal_connect_after(engineWidget, "realize", G_CALLBACK(_onEngineStarted),
+                         window);
+  gtk_widget_realize(engineWidget);
+
+  /// The switches are not left in the environment for the other engines.
+  if (!window->isEngineRunning) {
+    FLWM_LOG_WARNING("The engine of window %s is not started, it is started "
+                     "when the window is shown.",
+                     window->id.c_str());
+    _cancelEngineStart(window);
   }
+  _applyGLAreaAlpha(window);
+
+  gtk_widget_grab_focus(GTK_WIDGET(view));
 }
 
-void FLWM::WindowManager::setTitle(std::string title) {
-  gtk_window_set_title(window->window, title.c_str());
+gboolean _onStartEngineIdle(gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
 
-  if (gtk_layer_is_layer_window(GTK_WINDOW(window->window))) {
-    gtk_layer_set_namespace(GTK_WINDOW(window->window), title.c_str());
-  }
+  /// The source is removed by returning G_SOURCE_REMOVE.
+  window->engineStartSourceId = 0;
+  _startEngine(window);
+
+  return G_SOURCE_REMOVE;
 }
 
-void FLWM::WindowManager::setIsDecorated(bool isDecorated) {
-  gtk_window_set_decorated(window->window, isDecorated);
+/**
+ * Paint the color of the native window.
+ */
+gboolean _onNativeDraw(GtkWidget *widget, cairo_t *cairo, gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+
+  /// A soft hidden window draws nothing.
+  uint32_t color = window->isSoftHidden ? 0 : window->spec.color;
+
+  cairo_set_operator(cairo, CAIRO_OPERATOR_SOURCE);
+  cairo_set_source_rgba(cairo, ((color >> 16) & 0xFF) / 255.0,
+                        ((color >> 8) & 0xFF) / 255.0, (color & 0xFF) / 255.0,
+                        ((color >> 24) & 0xFF) / 255.0);
+  cairo_paint(cairo);
+
+  return TRUE;
 }
 
-FlValue *FLWM::WindowManager::isWindowIdUsed(std::string id) {
-  bool used = windows.find(id) != windows.end();
-  return fl_value_new_bool(used);
+/**
+ * Called when the pointer enters or leaves the native window. The event is
+ * sent to the engine of the window chosen for it.
+ */
+gboolean _onNativeCrossing(GtkWidget *widget, GdkEventCrossing *event,
+                           gpointer userData) {
+  FLWM::Window *window = (FLWM::Window *)userData;
+  const char *name =
+      event->type == GDK_ENTER_NOTIFY ? "pointerEnter" : "pointerLeave";
+
+  FlValue *data = fl_value_new_map();
+  fl_value_set_string_take(data, "x", fl_value_new_float(event->x));
+  fl_value_set_string_take(data, "y", fl_value_new_float(event->y));
+  FLWM::EventStream::emitTo(window->spec.eventWindowId, window->id, name,
+                            data);
+
+  return FALSE;
+}
+
+/**
+ * Make the window paint its color with cairo instead of a flutter view. GDK
+ * draws it into a shared memory buffer, so the window needs no GL context.
+ */
+void _attachNativeContent(FLWM::Window *window) {
+  GtkWidget *widget = GTK_WIDGET(window->window);
+
+  gtk_widget_set_app_paintable(widget, TRUE);
+  gtk_widget_add_events(widget, GDK_ENTER_NOTIFY_MASK | GDK_LEAVE_NOTIFY_MASK);
+
+  g_signal_connect(widget, "draw", G_CALLBACK(_onNativeDraw), window);
+  g_signal_connect(widget, "enter-notify-event", G_CALLBACK(_onNativeCrossing),
+                   window);
+  g_signal_connect(widget, "leave-notify-event", G_CALLBACK(_onNativeCrossing),
+                   window);
 }
 
-void FLWM::WindowManager::createWindow(std::string id, std::string title,
-                                       unsigned int width, unsigned int height,
-                                       bool isLayer,
-                                       std::vector<std::string> args) {
+bool FLWM::WindowManager::createWindow(std::string id, WindowSpec spec,
+                                       FlValue *initialPayload) {
 
   /// Check if the ID is already taken
   if (windows.find(id) != windows.end()) {
-    std::cerr << "The ID is already taken! Cannot create new window"
-              << std::endl;
-    return;
+    FLWM_LOG_ERROR("The ID is already taken! Cannot create new window: %s",
+                   id.c_str());
+    return false;
   }
 
   /// Create a new window for the application
   GtkWindow *newWindow = GTK_WINDOW(gtk_window_new(GTK_WINDOW_TOPLEVEL));
   if (newWindow == NULL) {
-    std::cerr << "Failed to create a new window!" << std::endl;
-    return;
+    FLWM_LOG_ERROR("Failed to create a new window!");
+    return false;
   }
 
   /// Add the window to the list of windows
   addWindow(newWindow, id);
 
   /// Set the default size of the window
-  gtk_window_set_default_size(GTK_WINDOW(newWindow), width, height);
+  gtk_window_set_default_size(GTK_WINDOW(newWindow), spec.width, spec.height);
+
+  /// The visual is chosen when the window is realized, so it is set first to
+  /// avoid recreating the surface, and drawing an opaque first frame. A native
+  /// window is always transparent, so that the alpha of its color can change.
+  if (spec.transparent || spec.isNative) {
+    _setTransparentVisual(&windows[id]);
+  }
 
   FLWM::WindowManager manager = FLWM::WindowManager(id);
-  manager.setSize(width, height);
+  manager.setSize(spec.width, spec.height);
 
-  if (isLayer) {
+  if (spec.isLayer) {
     convertToLayer(newWindow);
+
+    /// Set the monitor before showing, so that the surface is not remapped.
+    if (spec.monitor >= 0) {
+      manager.setMonitor(spec.monitor);
+    }
   }
 
   /// Set the title of the window
-  manager.setTitle(title);
+  manager.setTitle(spec.title);
+
+  /// The whole layer state is set before the window is mapped, so the
+  /// compositor configures the surface once, instead of once for each setter
+  /// called by the dart code after the window is shown.
+  if (spec.isLayer) {
+    if (spec.layer.layerNamespace.empty()) {
+      spec.layer.layerNamespace = spec.title;
+    }
+    manager.applyLayerSpec(spec.layer);
+  }
 
   /// Enable or diable the title bar for the new window
-  manager.setIsDecorated(!isLayer);
-
-  /// Show the new window
-  gtk_widget_show(GTK_WIDGET(newWindow));
-
-  /// Create the dart VM and start the flutter engine
-  g_autoptr(FlDartProject) project = fl_dart_project_new();
+  manager.setIsDecorated(!spec.isLayer);
 
-  /// CLI arguments to be passed to the dart entrypoint main() function
-  /// The last item in this array must be a NULL pointer, to indicate the end of
-  /// the array items. Otherwise errors will occur.
-  int cli_args_size = args.size() + 1;
-  char **cli_args = new char *[cli_args_size];
+  /// Keep the properties of the window, to start the engine later.
+  Window *window = &windows[id];
+  window->spec = spec;
 
-  for (size_t i = 0; i < args.size(); ++i) {
-    cli_args[i] = new char[args[i].size() + 1];
-    strcpy(cli_args[i], args[i].c_str());
+  if (spec.isNative) {
+    _attachNativeContent(window);
   }
 
-  /// CLI arguments list must be terminated with a NULL pointer
-  /// Otherwise, the dart VM will crash
-  cli_args[cli_args_size - 1] = nullptr;
-
-  fl_dart_project_set_dart_entrypoint_arguments(project, cli_args);
+  /// The payload is kept as it is, so it is not encoded again until the dart
+  /// code of the window takes it.
+  if (initialPayload != nullptr) {
+    window->initialPayload.reset(fl_value_ref(initialPayload));
+  }
 
-  FlView *view = fl_view_new(project);
-  gtk_widget_show(GTK_WIDGET(view));
-  gtk_container_add(GTK_CONTAINER(newWindow), GTK_WIDGET(view));
+  if (!spec.deferEngine) {
+    /// Show the new window
+    gtk_widget_show(GTK_WIDGET(newWindow));
 
-  /// Register the plugins for the flutter application, to the new flutter
-  /// view/engine
-  fl_register_plugins(FL_PLUGIN_REGISTRY(view));
+    _startEngine(window);
+    return true;
+  }
 
-  gtk_widget_grab_focus(GTK_WIDGET(view));
+  /// Create the window resources without showing it, so that showing it later
+  /// only needs the engine to be started.
+  gtk_widget_realize(GTK_WIDGET(newWindow));
 
-  /// Free the CLI args array
-  for (size_t i = 0; i < args.size(); ++i) {
-    delete[] cli_args[i];
+  if (spec.preloadEngine) {
+    /// The low priority lets the windows that are already shown draw their
+    /// frames first.
+    window->engineStartSourceId =
+        g_idle_add_full(G_PRIORITY_LOW, _onStartEngineIdle, window, NULL);
   }
-  delete[] cli_args;
+
+  return true;
 }
 
 /**
@@ -297,55 +1361,218 @@ _convertKeyboardInteractivity(FLWM::KeyboardInteractivity kbInteractivity) {
   }
 }
 
+FLWM::KeyboardInteractivity _getKeyboardInteractivity(GtkWindow *window) {
+  switch (gtk_layer_get_keyboard_mode(window)) {
+  case GTK_LAYER_SHELL_KEYBOARD_MODE_ON_DEMAND:
+    return FLWM::KeyboardInteractivity::ON_DEMAND;
+  case GTK_LAYER_SHELL_KEYBOARD_MODE_EXCLUSIVE:
+    return FLWM::KeyboardInteractivity::EXCLUSIVE;
+  default:
+    return FLWM::KeyboardInteractivity::NONE;
+  }
+}
+
+/**
+ * Hide or show the content of the window, while keeping its surface mapped.
+ * The changes are committed along with the next frame of the window.
+ */
+void _setSoftHidden(FLWM::Window *window, bool isSoftHidden) {
+  if (window->isSoftHidden == isSoftHidden) {
+    return;
+  }
+  window->isSoftHidden = isSoftHidden;
+
+  /// A hidden window must not take the keyboard focus.
+  if (isSoftHidden) {
+    window->softHiddenKeyboardMode = _getKeyboardInteractivity(window->window);
+    gtk_layer_set_keyboard_mode(window->window,
+                                GTK_LAYER_SHELL_KEYBOARD_MODE_NONE);
+  } else {
+    gtk_layer_set_keyboard_mode(
+        window->window,
+        _convertKeyboardInteractivity(window->softHiddenKeyboardMode));
+  }
+
+  /// A hidden window must not reserve space on the monitor. The zone set by
+  /// the user is kept in exclusiveZone.
+  if (isSoftHidden) {
+    window->softHiddenAutoExclusiveZone =
+        gtk_layer_auto_exclusive_zone_is_enabled(window->window);
+    gtk_layer_set_exclusive_zone(window->window, 0);
+  } else if (window->softHiddenAutoExclusiveZone) {
+    gtk_layer_auto_exclusive_zone_enable(window->window);
+  } else {
+    gtk_layer_set_exclusive_zone(window->window, window->exclusiveZone);
+  }
+
+  /// The background of a transparent window is not painted, so the window
+  /// draws nothing without its view. The view keeps its last frame, which is
+  /// drawn again when it is shown.
+  if (window->view != NULL) {
+    gtk_widget_set_child_visible(GTK_WIDGET(window->view), !isSoftHidden);
+  }
+  gtk_widget_queue_draw(GTK_WIDGET(window->window));
+
+  _queueSurfaceState(window, FLWM::SURFACE_STATE_INPUT_REGION |
+                                 FLWM::SURFACE_STATE_OPAQUE_REGION);
+}
+
 void FLWM::WindowManager::setKeyboardInteractivity(
     KeyboardInteractivity interactivity) {
+  /// The mode is applied when the window is shown again.
+  if (window->isSoftHidden) {
+    window->softHiddenKeyboardMode = interactivity;
+    return;
+  }
+
   gtk_layer_set_keyboard_mode(GTK_WINDOW(window->window),
                               _convertKeyboardInteractivity(interactivity));
 }
 
+void FLWM::WindowManager::applyLayerSpec(const LayerSpec &layer) {
+  setLayer(layer.layer);
+  setLayerAnchor(layer.anchor);
+  setLayerMargin(layer.marginTop, layer.marginRight, layer.marginBottom,
+                 layer.marginLeft);
+  setKeyboardInteractivity(layer.keyboardMode);
+
+  if (layer.autoExclusiveZone) {
+    enableLayerAutoExclusive();
+  } else if (layer.exclusiveZone != 0) {
+    setLayerExclusiveZone(layer.exclusiveZone);
+  }
+
+  if (!layer.layerNamespace.empty()) {
+    gtk_layer_set_namespace(window->window, layer.layerNamespace.c_str());
+  }
+}
+
 void FLWM::WindowManager::enableLayerAutoExclusive() {
+  /// The zone is applied when the window is shown again.
+  if (window->isSoftHidden) {
+    window->softHiddenAutoExclusiveZone = true;
+    return;
+  }
+
   gtk_layer_auto_exclusive_zone_enable(GTK_WINDOW(window->window));
 }
 
 void FLWM::WindowManager::setLayerExclusiveZone(int length) {
-  GtkWindow *w = GTK_WINDOW(window->window);
+  window->exclusiveZone = length;
+
+  /// The zone is applied when the window is shown again.
+  if (window->isSoftHidden) {
+    window->softHiddenAutoExclusiveZone = false;
+    return;
+  }
 
-  struct zwlr_layer_surface_v1 *layerSurface =
-      gtk_layer_get_zwlr_layer_surface_v1(w);
-  zwlr_layer_surface_v1_set_exclusive_zone(layerSurface, length);
+  /// The zone is always set through the library, which sends it to the mapped
+  /// layer surface and queues the commit. It also keeps the zone, so that the
+  /// zone is sent again when the window is remapped. (e.g: Moved to another
+  /// monitor, or the namespace is changed)
+  gtk_layer_set_exclusive_zone(GTK_WINDOW(window->window), length);
 }
 
-void FLWM::WindowManager::closeWindow() {
-  /// Destroy the input region if it is not NULL
-  if (window->inputRegion != NULL) {
-    wl_region_destroy(window->inputRegion);
+int FLWM::WindowManager::getLayerExclusiveZone() {
+  return window->exclusiveZone;
+}
+
+void FLWM::WindowManager::animateGeometry(int animationId,
+                                          WindowGeometry target,
+                                          unsigned int durationMs,
+                                          AnimationCurve curve) {
+  FLWM::GeometryAnimator::start(window->id, window->window, animationId, target,
+                                durationMs, curve);
+}
+
+void FLWM::WindowManager::stopGeometryAnimation() {
+  FLWM::GeometryAnimator::stop(window->id);
+}
+
+FlValue *FLWM::WindowManager::takeInitialPayload() {
+  FlValue *payload = window->initialPayload.get();
+  if (payload == NULL) {
+    return NULL;
+  }
+
+  fl_value_ref(payload);
+  window->initialPayload.reset();
+  return payload;
+}
+
+void FLWM::WindowManager::setNativeColor(uint32_t color) {
+  if (!window->spec.isNative) {
+    FLWM_LOG_WARNING("Cannot set the color of window %s, since it is not a "
+                     "native window.",
+                     window->id.c_str());
+    return;
   }
 
-  GtkWidget *fl_view = GTK_WIDGET(
-      gtk_container_get_children(GTK_CONTAINER(window->window))->data);
-  gtk_container_remove(GTK_CONTAINER(window->window), fl_view);
-  gtk_window_close(window->window);
+  window->spec.color = color;
+  gtk_widget_queue_draw(GTK_WIDGET(window->window));
+}
 
-  /// Remove the window from the list of windows
-  windows.erase(window->id);
+void FLWM::WindowManager::setEvictable(bool evictable) {
+  window->evictable = evictable;
+}
 
-  /// Free the window object
-  window->id = "";
-  window->window = nullptr;
+bool FLWM::WindowManager::isEvictable() { return window->evictable; }
 
-  /// Clear the method channels for this window
-  for (auto const &[key, val] : window->methodChannels) {
-    fl_method_channel_set_method_call_handler(val, NULL, NULL, NULL);
-    g_object_unref(val);
+void FLWM::WindowManager::notifyMemoryPressure() {
+  _sendMemoryPressure(window);
+}
+
+GtkWindow *FLWM::WindowManager::getGtkWindow() { return window->window; }
+
+void FLWM::WindowManager::closeWindow() {
+  std::string id = window->id;
+  GtkWindow *gtkWindow = window->window;
+  FlView *flView = window->view;
+
+  /// Remove the window from the list of windows and free its resources.
+  /// The window record is freed here, so it must not be used after this.
+  removeWindow(id);
+  window = nullptr;
+
+  if (flView != NULL) {
+    gtk_container_remove(GTK_CONTAINER(gtkWindow), GTK_WIDGET(flView));
   }
-  window->methodChannels.clear();
+  gtk_window_close(gtkWindow);
+
+  FLWM::EventStream::emit(id, "closed");
 }
 
-void FLWM::WindowManager::hideWindow() {
-  gtk_widget_hide(GTK_WIDGET(window->window));
+void FLWM::WindowManager::hideWindow(bool notifyMemoryPressure, bool soft) {
+  GtkWidget *widget = GTK_WIDGET(window->window);
+
+  /// The surface is kept only if the window can draw nothing, and it is not
+  /// listed as a toplevel by the compositor.
+  if (soft && (!window->isTransparent ||
+               !gtk_layer_is_layer_window(window->window))) {
+    FLWM_LOG_DEBUG("Window %s is hidden as usual, since only the transparent "
+                   "layer windows can be soft hidden.",
+                   window->id.c_str());
+    soft = false;
+  }
+
+  if (soft && gtk_widget_get_mapped(widget)) {
+    _setSoftHidden(window, true);
+  } else {
+    _setSoftHidden(window, false);
+    gtk_widget_hide(widget);
+  }
+
+  if (notifyMemoryPressure) {
+    this->notifyMemoryPressure();
+  }
 }
 
 void FLWM::WindowManager::showWindow() {
+  /// Start the deferred engine before showing, so that the first frame of the
+  /// window is not empty.
+  _startEngine(window);
+
+  _setSoftHidden(window, false);
   gtk_widget_show(GTK_WIDGET(window->window));
 }
 
@@ -354,7 +1581,8 @@ FlValue *FLWM::WindowManager::isVisible() {
     return fl_value_new_bool(false);
   }
 
-  bool visible = gtk_widget_is_visible(GTK_WIDGET(window->window));
+  bool visible = gtk_widget_is_visible(GTK_WIDGET(window->window)) &&
+                 !window->isSoftHidden;
   return fl_value_new_bool(
       visible); 
 }
@@ -365,127 +1593,210 @@ void FLWM::WindowManager::setFocus() {
 
 void FLWM::WindowManager::createMethodChannel(
     std::string channelName, FlMethodChannelMethodCallHandler handler,
-    void *userData) {
+    void *userData, GDestroyNotify destroyNotify) {
   /// Get the flutter view from the window. This is used as the registrar for
   /// getting the messenger.
-  GtkWindow *gtkWindow = window->window;
-  FlView *flView =
-      FL_VIEW(gtk_container_get_children(GTK_CONTAINER(gtkWindow))->data);
-  if (!FL_IS_VIEW(flView)) {
-    std::cerr << "The flutter view is not found in the window!" << std::endl;
+  if (window->view == NULL) {
+    FLWM_LOG_ERROR("The flutter view is not found in the window!");
+    return;
+  }
+  FLWM::GObjectRef<FlStandardMethodCodec> codec(
+      fl_standard_method_codec_new());
+  FLWM::GObjectRef<FlMethodChannel> channel(
+      fl_method_channel_new(_getMessenger(window), channelName.c_str(),
+                            FL_METHOD_CODEC(codec.get())));
+
+  fl_method_channel_set_method_call_handler(channel, handler, userData,
+                                            destroyNotify);
+
+  /// Replace the channel with the same name, if there is one. Its handler is
+  /// cleared first, so the messages are not delivered to both of them.
+  auto iter = window->methodChannels.find(channelName);
+  if (iter != window->methodChannels.end()) {
+    fl_method_channel_set_method_call_handler(iter->second, NULL, NULL, NULL);
   }
-  FlPluginRegistry *registry = FL_PLUGIN_REGISTRY(flView);
-  g_autoptr(FlPluginRegistrar) registrar =
-      fl_plugin_registry_get_registrar_for_plugin(registry,
-                                                  "FlLinuxWindowManagerPlugin");
-
-  g_autoptr(FlStandardMethodCodec) codec = fl_standard_method_codec_new();
-  g_autoptr(FlMethodChannel) channel =
-      fl_method_channel_new(fl_plugin_registrar_get_messenger(registrar),
-                            channelName.c_str(), FL_METHOD_CODEC(codec));
-
-  fl_method_channel_set_method_call_handler(channel, handler, userData, free);
 
-  /// Add the channel to the window's method channels list
-  window->methodChannels[channelName] = channel;
+  /// Add the channel to the window's method channels list. The list keeps the
+  /// only reference of the channel.
+  window->methodChannels[channelName] = std::move(channel);
 }
 
 void FLWM::WindowManager::sendMethodCall(std::string channelName,
                                          std::string methodName,
                                          FlValue *args) {
   /// Get the method channel from the window
-  FlMethodChannel *channel = window->methodChannels[channelName];
+  auto iter = window->methodChannels.find(channelName);
 
-  if (channel == NULL) {
-    std::cerr << "The method channel is not found for the given name!"
-              << std::endl;
+  if (iter == window->methodChannels.end()) {
+    FLWM_LOG_WARNING("The method channel is not found for the given name: %s",
+                     channelName.c_str());
     return;
   }
 
   /// Send the method call to the channel
-  fl_method_channel_invoke_method(channel, methodName.c_str(), args, NULL, NULL,
+  fl_method_channel_invoke_method(iter->second, methodName.c_str(), args, NULL, NULL,
                                   NULL);
 }
 
 void FLWM::WindowManager::setInfinteInputRegion() {
-  if (window->inputRegion != NULL) {
-    wl_region_destroy(window->inputRegion);
-    window->inputRegion = NULL;
-  }
+  window->inputRegion.reset();
+  window->inputMaskRects.clear();
 
-  /// Set the input region to NULL for the window
-  GdkWindow *gdkWindow = gtk_widget_get_window(GTK_WIDGET(window->window));
-  struct wl_surface *wlSurface = gdk_wayland_window_get_wl_surface(gdkWindow);
-
-  wl_surface_set_input_region(wlSurface, NULL);
-  wl_surface_commit(wlSurface);
+  /// The NULL region is set to the window with the next frame.
+  _queueSurfaceState(window, FLWM::SURFACE_STATE_INPUT_REGION);
 }
 
 void FLWM::WindowManager::addInputRegion(int x, int y, int width, int height) {
-  if (window->inputRegion == NULL) {
-    window->inputRegion =
-        wl_compositor_create_region(FLWM::WindowManager::compositor);
+  window->inputMaskRects.clear();
+
+  if (window->inputRegion.get() == NULL) {
+    window->inputRegion.reset(
+        wl_compositor_create_region(FLWM::WindowManager::compositor));
   }
 
   wl_region_add(window->inputRegion, x, y, width, height);
 
-  /// Set the input region to the window
-  GdkWindow *gdkWindow = gtk_widget_get_window(GTK_WIDGET(window->window));
-  struct wl_surface *wlSurface = gdk_wayland_window_get_wl_surface(gdkWindow);
-
-  wl_surface_set_input_region(wlSurface, window->inputRegion);
-  wl_surface_commit(wlSurface);
+  _queueSurfaceState(window, FLWM::SURFACE_STATE_INPUT_REGION);
 }
 
 void FLWM::WindowManager::subtractInputRegion(int x, int y, int width,
                                               int height) {
-  if (window->inputRegion == NULL) {
-    window->inputRegion =
-        wl_compositor_create_region(FLWM::WindowManager::compositor);
+  window->inputMaskRects.clear();
+
+  if (window->inputRegion.get() == NULL) {
+    window->inputRegion.reset(
+        wl_compositor_create_region(FLWM::WindowManager::compositor));
     wl_region_add(window->inputRegion, 0, 0, INT32_MAX, INT32_MAX);
   }
 
   wl_region_subtract(window->inputRegion, x, y, width, height);
 
-  /// Set the input region to the window
-  GdkWindow *gdkWindow = gtk_widget_get_window(GTK_WIDGET(window->window));
-  struct wl_surface *wlSurface = gdk_wayland_window_get_wl_surface(gdkWindow);
+  _queueSurfaceState(window, FLWM::SURFACE_STATE_INPUT_REGION);
+}
+
+bool FLWM::WindowManager::setInputRegionMask(const Mask &mask,
+                                             double pixelRatio) {
+  std::vector<MaskRect> rects;
+  if (!FLWM::InputMask::toRects(mask, rects)) {
+    return false;
+  }
+
+  /// The rects are expanded to the surface pixels that they partially cover,
+  /// same as the rects added by the dart code.
+  if (pixelRatio > 0 && pixelRatio != 1) {
+    for (MaskRect &rect : rects) {
+      int left = (int)std::floor(rect.x / pixelRatio);
+      int top = (int)std::floor(rect.y / pixelRatio);
+      int right = (int)std::ceil((rect.x + rect.width) / pixelRatio);
+      int bottom = (int)std::ceil((rect.y + rect.height) / pixelRatio);
+      rect = {left, top, right - left, bottom - top};
+    }
+  }
+
+  /// The mask is usually sent for every frame, while the shape changes much
+  /// less often.
+  if (window->inputRegion.get() != NULL && rects == window->inputMaskRects) {
+    return true;
+  }
+
+  /// An empty region is kept as is, so a fully clear mask takes no input.
+  window->inputRegion.reset(
+      wl_compositor_create_region(FLWM::WindowManager::compositor));
+  for (const MaskRect &rect : rects) {
+    wl_region_add(window->inputRegion, rect.x, rect.y, rect.width,
+                  rect.height);
+  }
+  window->inputMaskRects = std::move(rects);
 
-  wl_surface_set_input_region(wlSurface, window->inputRegion);
-  wl_surface_commit(wlSurface);
+  _queueSurfaceState(window, FLWM::SURFACE_STATE_INPUT_REGION);
+  return true;
 }
 
-/// get monitor list
-FlValue *FLWM::WindowManager::getMonitorList() {
-  GdkDisplay *display = gdk_display_get_default();
-  if (!display) {
-    std::cerr << "Failed to get default GDK display." << std::endl;
-    return fl_value_new_list(); // Return empty list on error
+void FLWM::WindowManager::clearOpaqueRegion() {
+  window->opaqueRegion.reset();
+
+  /// The NULL region is set to the window with the next frame.
+  _queueSurfaceState(window, FLWM::SURFACE_STATE_OPAQUE_REGION);
+}
+
+void FLWM::WindowManager::addOpaqueRegion(int x, int y, int width,
+                                          int height) {
+  if (window->opaqueRegion.get() == NULL) {
+    window->opaqueRegion.reset(cairo_region_create());
   }
 
-  g_autoptr(FlValue) result_list = fl_value_new_list();
-  int n_monitors = gdk_display_get_n_monitors(display);
+  cairo_rectangle_int_t rect = {x, y, width, height};
+  cairo_region_union_rectangle(window->opaqueRegion, &rect);
 
-  for (int i = 0; i < n_monitors; i++) {
-    GdkMonitor *monitor = gdk_display_get_monitor(display, i);
-    if (monitor) {
-      // Simple version like in wayland_layer_shell_plugin:
-      const char *model = gdk_monitor_get_model(monitor);
-      if (!model)
-        model = "Unknown"; // Handle NULL model
-
-      gchar *val = g_strdup_printf("%i:%s", i, model);
-      fl_value_append_take(result_list, fl_value_new_string(val));
-      g_free(val); // g_strdup_printf allocates, so we need to free
+  _queueSurfaceState(window, FLWM::SURFACE_STATE_OPAQUE_REGION);
+}
+
+void FLWM::WindowManager::subtractOpaqueRegion(int x, int y, int width,
+                                               int height) {
+  if (window->opaqueRegion.get() == NULL) {
+    return;
+  }
+
+  cairo_rectangle_int_t rect = {x, y, width, height};
+  cairo_region_subtract_rectangle(window->opaqueRegion, &rect);
+
+  _queueSurfaceState(window, FLWM::SURFACE_STATE_OPAQUE_REGION);
+}
+
+FlValue *FLWM::WindowManager::getScale() {
+  int bufferScale = gtk_widget_get_scale_factor(GTK_WIDGET(window->window));
+
+  /// Use the integer scale if the compositor does not send a preferred scale.
+  double scale =
+      window->preferredScale > 0 ? window->preferredScale : bufferScale;
+
+  FlValue *result = fl_value_new_map();
+  fl_value_set_string_take(result, "scale", fl_value_new_float(scale));
+  fl_value_set_string_take(result, "bufferScale",
+                           fl_value_new_int(bufferScale));
+  return result;
+}
+
+void FLWM::WindowManager::setFrameTelemetry(bool enabled) {
+  if (enabled) {
+    FLWM::FrameTelemetry::enable(window->id, window->window);
+  } else {
+    FLWM::FrameTelemetry::disable(window->id);
+  }
+}
+
+FlValue *FLWM::WindowManager::getFrameStats() {
+  return FLWM::FrameTelemetry::getStats(window->id);
+}
+
+FlValue *FLWM::WindowManager::getMemoryUsage() {
+  FlValue *engines = fl_value_new_map();
+  for (auto const &[id, record] : windows) {
+    if (record.isEngineRunning && record.engineResidentBytes > 0) {
+      fl_value_set_string_take(engines, id.c_str(),
+                               fl_value_new_int(record.engineResidentBytes));
     }
   }
-  return fl_value_ref(result_list); // Return a new reference
+
+  FlValue *result = fl_value_new_map();
+  fl_value_set_string_take(
+      result, "residentBytes",
+      fl_value_new_int(FLWM::EngineProject::getResidentBytes()));
+  fl_value_set_string_take(result, "engineStartBytes", engines);
+  return result;
+}
+
+FlValue *FLWM::WindowManager::getMonitorList() {
+  return FLWM::MonitorManager::getMonitorList();
+}
+
+FlValue *FLWM::WindowManager::getMonitors() {
+  return FLWM::MonitorManager::getMonitors();
 }
 
 void FLWM::WindowManager::setMonitor(int monitor_index) {
   if (!this->window || !this->window->window) {
-    std::cerr << "FLWM::WindowManager::setMonitor: Window is not valid."
-              << std::endl;
+    FLWM_LOG_WARNING("FLWM::WindowManager::setMonitor: Window is not valid.");
     return;
   }
 
@@ -496,9 +1807,8 @@ void FLWM::WindowManager::setMonitor(int monitor_index) {
   // behavior. flwm usually calls gtk_layer_init_for_window via convertToLayer
   // or in createWindow.
   if (!gtk_layer_is_layer_window(gtk_window)) {
-    std::cerr << "FLWM::WindowManager::setMonitor: Window is not a layer shell "
-                 "window. Call convertToLayer() first."
-              << std::endl;
+    FLWM_LOG_WARNING("FLWM::WindowManager::setMonitor: Window is not a layer "
+                     "shell window. Call convertToLayer() first.");
     // Optionally, you could try to call gtk_layer_init_for_window(gtk_window);
     // here if desired, but it's better if the Dart side ensures the window is
     // already a layer. gtk_layer_init_for_window(gtk_window); // Uncomment if
@@ -508,34 +1818,70 @@ void FLWM::WindowManager::setMonitor(int monitor_index) {
   GdkDisplay *display = gtk_widget_get_display(
       GTK_WIDGET(gtk_window)); // Get display associated with the window
   if (!display) {
-    std::cerr << "FLWM::WindowManager::setMonitor: Failed to get GDK display "
-                 "for window."
-              << std::endl;
+    FLWM_LOG_ERROR("FLWM::WindowManager::setMonitor: Failed to get GDK display "
+                   "for window.");
     return;
   }
 
   if (monitor_index == -1) { // Special value to unset or use default
     gtk_layer_set_monitor(gtk_window, NULL);
-    std::cout << "FLWM::WindowManager::setMonitor: Unset monitor for window ID "
-              << this->window->id << std::endl;
+    FLWM_LOG_DEBUG("FLWM::WindowManager::setMonitor: Unset monitor for window "
+                   "ID %s",
+                   this->window->id.c_str());
   } else {
     int n_monitors = gdk_display_get_n_monitors(display);
     if (monitor_index < 0 || monitor_index >= n_monitors) {
-      std::cerr << "FLWM::WindowManager::setMonitor: Invalid monitor index "
-                << monitor_index << ". Available monitors: " << n_monitors
-                << std::endl;
+      FLWM_LOG_WARNING("FLWM::WindowManager::setMonitor: Invalid monitor index "
+                       "%d. Available monitors: %d",
+                       monitor_index, n_monitors);
       return;
     }
     GdkMonitor *monitor = gdk_display_get_monitor(display, monitor_index);
     if (!monitor) {
-      std::cerr << "FLWM::WindowManager::setMonitor: Failed to get GdkMonitor "
-                   "for index "
-                << monitor_index << std::endl;
+      FLWM_LOG_ERROR("FLWM::WindowManager::setMonitor: Failed to get GdkMonitor "
+                     "for index %d",
+                     monitor_index);
       return;
     }
     gtk_layer_set_monitor(gtk_window, monitor);
-    std::cout << "FLWM::WindowManager::setMonitor: Set monitor "
-              << monitor_index << " for window ID " << this->window->id
-              << std::endl;
+    FLWM_LOG_DEBUG("FLWM::WindowManager::setMonitor: Set monitor %d for window "
+                   "ID %s",
+                   monitor_index, this->window->id.c_str());
+  }
+}
+
+bool FLWM::WindowManager::migrateToMonitor(int monitorIndex) {
+  GtkWidget *widget = GTK_WIDGET(window->window);
+
+  if (!gtk_layer_is_layer_window(window->window)) {
+    FLWM_LOG_WARNING("Cannot move window %s to another monitor, since it is "
+                     "not a layer window.",
+                     window->id.c_str());
+    return false;
   }
-}
\ No newline at end of file
+
+  GdkMonitor *monitor = _getMonitor(widget, monitorIndex);
+  if (monitor == NULL) {
+    FLWM_LOG_WARNING("Cannot move window %s to monitor %d, since it is not "
+                     "found.",
+                     window->id.c_str(), monitorIndex);
+    return false;
+  }
+
+  _finishMigration(window, false);
+
+  /// A hidden window is not remapped, so it is moved right away.
+  if (!gtk_widget_get_mapped(widget)) {
+    gtk_layer_set_monitor(window->window, monitor);
+
+    window->migrationStage = FLWM::MIGRATION_SWAPPING;
+    window->migrationMonitor = monitorIndex;
+    _finishMigration(window, true);
+    return true;
+  }
+
+  window->migrationStage = FLWM::MIGRATION_STAGING;
+  window->migrationMonitor = monitorIndex;
+  window->migrationPlaceholder = _createPlaceholder(window, monitor);
+  return true;
+}
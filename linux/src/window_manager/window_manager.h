@@ -6,6 +6,11 @@
 #include <map>
 
 #include <flutter_linux/flutter_linux.h>
+#include <engine/engine_project.h>
+#include <handles/handles.h>
+#include <input_mask/input_mask.h>
+#include <window_manager/geometry_animator.h>
+#include <protocol_bindings/fractional_scale_v1_protocol_client.h>
 #include <wayland-client.h>
 
 /**
@@ -21,6 +26,170 @@ void fl_register_plugins(FlPluginRegistry *registry);
 
 namespace FLWM
 {
+    enum __attribute__((visibility("default"))) Layer
+    {
+        LAYER_BACKGROUND = 1,
+        LAYER_BOTTOM,
+        LAYER_TOP,
+        LAYER_OVERLAY
+    };
+
+    enum __attribute__((visibility("default"))) ScreenEdge
+    {
+        SCREEN_EDGE_TOP = 1 << 0,
+        SCREEN_EDGE_RIGHT = 1 << 1,
+        SCREEN_EDGE_BOTTOM = 1 << 2,
+        SCREEN_EDGE_LEFT = 1 << 3,
+    };
+
+    enum __attribute__((visibility("default"))) KeyboardInteractivity
+    {
+        NONE,
+        EXCLUSIVE,
+        ON_DEMAND
+    };
+
+    /**
+     * The steps of moving a shown layer window to another monitor.
+     */
+    enum __attribute__((visibility("default"))) MigrationStage
+    {
+        /**
+         * The window is not moving.
+         */
+        MIGRATION_NONE = 0,
+
+        /**
+         * An empty placeholder window is shown on the target monitor, and it is waiting for its
+         * first frame.
+         */
+        MIGRATION_STAGING,
+
+        /**
+         * The window is remapped onto the target monitor.
+         */
+        MIGRATION_REMAPPING,
+
+        /**
+         * The window is mapped on the target monitor, and it is waiting for its first frame
+         * there, to remove the placeholder.
+         */
+        MIGRATION_SWAPPING
+    };
+
+    /**
+     * The initial layer shell state of a layer window. It is applied before the window is first
+     * mapped, so that the surface is configured once with the final state.
+     */
+    struct LayerSpec
+    {
+        Layer layer = LAYER_TOP;
+
+        /**
+         * The edges the window is anchored to. (ScreenEdge flags)
+         */
+        int anchor = 0;
+
+        unsigned int marginTop = 0;
+
+        unsigned int marginRight = 0;
+
+        unsigned int marginBottom = 0;
+
+        unsigned int marginLeft = 0;
+
+        int exclusiveZone = 0;
+
+        /**
+         * If the exclusive zone is calculated from the size of the window, instead of exclusiveZone.
+         */
+        bool autoExclusiveZone = false;
+
+        KeyboardInteractivity keyboardMode = ON_DEMAND;
+
+        /**
+         * The namespace of the layer surface, which the compositor uses to identify the kind of
+         * the window. (Empty to use the title the window is created with)
+         */
+        std::string layerNamespace;
+    };
+
+    /**
+     * The properties of a window that is created by the window manager.
+     */
+    struct WindowSpec
+    {
+        std::string title;
+
+        unsigned int width;
+
+        unsigned int height;
+
+        /**
+         * If the window needs to be created as a layer shell surface.
+         */
+        bool isLayer;
+
+        /**
+         * The arguments passed to the dart entrypoint of the new engine.
+         */
+        std::vector<std::string> args;
+
+        /**
+         * The name of the dart function run by the new engine instead of the rest of main().
+         * (Empty to run main())
+         */
+        std::string entrypoint;
+
+        /**
+         * The index of the monitor on which the layer window is shown. (-1 for the default monitor)
+         */
+        int monitor = -1;
+
+        /**
+         * The layer shell state of the window, if it is a layer window.
+         */
+        LayerSpec layer;
+
+        /**
+         * If the flutter engine is started when the window is first shown, instead of when it
+         * is created. The window is created hidden in this case.
+         */
+        bool deferEngine = false;
+
+        /**
+         * If the deferred engine is started in an idle callback, before the window is shown.
+         */
+        bool preloadEngine = false;
+
+        /**
+         * If the window is created with a transparent background. The RGBA visual and the alpha
+         * of the GL area are set before the window is realized.
+         */
+        bool transparent = false;
+
+        /**
+         * If the window has no flutter engine. It only paints its color, and its pointer events are
+         * sent to the engine of eventWindowId. (e.g: Hot zones, scrims and solid backgrounds)
+         */
+        bool isNative = false;
+
+        /**
+         * The color painted by a native window, in the ARGB format.
+         */
+        uint32_t color = 0;
+
+        /**
+         * The ID of the window whose engine receives the pointer events of a native window.
+         */
+        std::string eventWindowId;
+
+        /**
+         * The options applied when the engine of the window is started.
+         */
+        EngineOptions engineOptions;
+    };
+
     struct Window
     {
         /**
@@ -33,39 +202,194 @@ namespace FLWM
          */
         GtkWindow *window;
 
+        /**
+         * The flutter view added to the window. (NULL until the view is added)
+         */
+        FlView *view;
+
+        /**
+         * The GL area that renders the flutter view. This is resolved when it is first needed,
+         * and reset when the window is realized or unrealized. (NULL if not resolved yet)
+         */
+        GtkWidget *glArea;
+
+        /**
+         * The wayland surface of the window. This is resolved when it is first needed, and reset
+         * when the window is unmapped, since GDK creates a new wl_surface every time the window
+         * is shown. (NULL if not resolved yet)
+         */
+        struct wl_surface *wlSurface;
+
         /**
          * The input region associated with the window. This is used to control the area of the
          * window that can receive input events.
          */
-        wl_region *inputRegion;
+        WlProxy<wl_region, WL_REGION_DESTROY> inputRegion;
+
+        /**
+         * The rects of the input region set by setInputRegionMask(), in the surface coordinates.
+         * This is used to skip the masks that do not change the region. (Cleared when the input
+         * region is changed by the other methods)
+         */
+        std::vector<MaskRect> inputMaskRects;
+
+        /**
+         * The region of the window that is known to be fully opaque. The compositor does not
+         * blend the content below this region. (NULL if no region is set)
+         */
+        CairoRegionRef opaqueRegion;
+
+        /**
+         * The state of the window surface that is changed, but not applied to the surface yet.
+         * (SurfaceState flags) It is applied with the next frame of the window.
+         */
+        unsigned int pendingSurfaceState;
+
+        /**
+         * The frame clock whose paint signals apply the pending surface state. (NULL if the window
+         * is not realized)
+         */
+        GdkFrameClock *frameClock;
+
+        /**
+         * If the pending surface state is applied in the current frame, and waits to be committed.
+         */
+        bool isAwaitingCommit;
+
+        /**
+         * If the window is drawn in the current frame. GDK commits the surface of a drawn frame.
+         */
+        bool isFrameDrawn;
+
+        /**
+         * If the window has a transparent background. The GL area of a view added later is
+         * rendered with the alpha channel.
+         */
+        bool isTransparent;
+
+        /**
+         * If the window is hidden while its surface stays mapped. It draws nothing and has an
+         * empty input region, so it can be shown again with a single commit.
+         */
+        bool isSoftHidden;
+
+        /**
+         * The keyboard interactivity of the layer window, restored when it is shown after a soft
+         * hide.
+         */
+        KeyboardInteractivity softHiddenKeyboardMode;
+
+        /**
+         * If the exclusive zone of the layer window is calculated from its size, restored when it
+         * is shown after a soft hide. Otherwise exclusiveZone is restored.
+         */
+        bool softHiddenAutoExclusiveZone;
 
         /**
          * Stores the method channels created by the user for this window.
          */
-        std::map<std::string, FlMethodChannel *> methodChannels;
-    };
+        std::map<std::string, GObjectRef<FlMethodChannel>> methodChannels;
 
-    enum __attribute__((visibility("default"))) Layer
-    {
-        LAYER_BACKGROUND = 1,
-        LAYER_BOTTOM,
-        LAYER_TOP,
-        LAYER_OVERLAY
-    };
+        /**
+         * The monitor on which the window was mapped last time. This is used to detect when the
+         * window enters or leaves a monitor. (NULL if the window is not mapped)
+         */
+        GdkMonitor *monitor;
 
-    enum __attribute__((visibility("default"))) ScreenEdge
-    {
-        SCREEN_EDGE_TOP = 1 << 0,
-        SCREEN_EDGE_RIGHT = 1 << 1,
-        SCREEN_EDGE_BOTTOM = 1 << 2,
-        SCREEN_EDGE_LEFT = 1 << 3,
+        /**
+         * The fractional scale object of the window surface. This is created when the window is
+         * mapped, since GDK creates a new wl_surface every time the window is shown.
+         * (NULL if the compositor does not support the fractional scale protocol)
+         */
+        WlProxy<wp_fractional_scale_v1, WP_FRACTIONAL_SCALE_V1_DESTROY> fractionalScale;
+
+        /**
+         * The preferred scale of the window surface sent by the compositor. (e.g: 1.25, 1.5)
+         * 0 if the compositor did not send the preferred scale yet.
+         */
+        double preferredScale;
+
+        /**
+         * The exclusive zone of the layer window set by setLayerExclusiveZone().
+         */
+        int exclusiveZone;
+
+        /**
+         * The properties the window is created with. (Empty for the main window)
+         */
+        WindowSpec spec;
+
+        /**
+         * If the flutter engine of the window is started.
+         */
+        bool isEngineStarted;
+
+        /**
+         * If the engine of the view is running. The engine starts when the GL area of the view is
+         * realized, which may be later than the view is created. (e.g: When the window is shown)
+         */
+        bool isEngineRunning;
+
+        /**
+         * If the entrypoint arguments and the switches of the window are applied to the shared
+         * project, and its engine is about to start.
+         */
+        bool isEngineStarting;
+
+        /**
+         * The resident memory of the process when the engine start is prepared, in bytes.
+         */
+        gint64 engineStartResidentBytes;
+
+        /**
+         * The ID of the idle source that starts the deferred engine. (0 if not scheduled)
+         */
+        guint engineStartSourceId;
+
+        /**
+         * The growth of the resident memory of the process while the engine of the window was
+         * started, in bytes. (0 if not measured)
+         */
+        gint64 engineResidentBytes;
+
+        /**
+         * The value given to createWindow() for the new window, until the window takes it.
+         */
+        FlValueRef initialPayload;
+
+        /**
+         * If the window can be closed while it is hidden, when the system is under memory pressure.
+         */
+        bool evictable;
+
+        MigrationStage migrationStage;
+
+        /**
+         * The empty layer window that holds the place of the window on the monitor it is moved to.
+         * It takes the exclusive zone of the window there, until the window is drawn on that
+         * monitor. (NULL if the window is not moving)
+         */
+        GtkWidget *migrationPlaceholder;
+
+        /**
+         * The index of the monitor the window is moved to. (-1 if the window is not moving)
+         */
+        int migrationMonitor;
+
+        /**
+         * The ID of the idle source of the next step of the move. (0 if not scheduled)
+         */
+        guint migrationSourceId;
     };
 
-    enum __attribute__((visibility("default"))) KeyboardInteractivity
+    /**
+     * The double buffered states of the window surface that are applied with the frames of the
+     * window.
+     */
+    enum __attribute__((visibility("default"))) SurfaceState
     {
-        NONE,
-        EXCLUSIVE,
-        ON_DEMAND
+        SURFACE_STATE_INPUT_REGION = 1 << 0,
+        SURFACE_STATE_OPAQUE_REGION = 1 << 1,
     };
 
     class __attribute__((visibility("default"))) WindowManager
@@ -81,6 +405,11 @@ namespace FLWM
          */
         static wl_compositor *compositor;
 
+        /**
+         * The fractional scale manager object. (NULL if the compositor does not support it)
+         */
+        static wp_fractional_scale_manager_v1 *fractionalScaleManager;
+
     private:
         /**
          * A map of all windows created by this application. This is used to keep track of all windows
@@ -99,22 +428,51 @@ namespace FLWM
          */
         static void addWindow(GtkWindow *window, std::string id);
 
+        /**
+         * Remove the window from the list of windows managed by the window manager and free the
+         * resources associated with it. The GTK window itself is not destroyed.
+         */
+        static void removeWindow(std::string id);
+
+        /**
+         * Returns the ID of the given GTK window, or an empty string if the window is not
+         * managed by the window manager.
+         */
+        static std::string getWindowId(GtkWindow *window);
+
+        /**
+         * Returns the IDs of all windows.
+         */
+        static std::vector<std::string> getWindowIds();
+
         /**
          * Converts the role of the window to a layer shell surface.
          */
         static void convertToLayer(GtkWindow *window);
 
+        /**
+         * Set the layer shell state of the layer window at once. When the window is not mapped
+         * yet, the state is sent with the first commit of the surface.
+         */
+        void applyLayerSpec(const LayerSpec &layer);
+
         /**
          * Returns if a windowId is used or not.
          */
         static FlValue* isWindowIdUsed(std::string id);
 
-        static void createWindow(std::string id,
-                                 std::string title,
-                                 unsigned int width,
-                                 unsigned int height,
-                                 bool isLayer,
-                                 std::vector<std::string> args);
+        /**
+         * Returns if a window with the given ID is managed by the window manager.
+         */
+        static bool hasWindow(std::string id);
+
+        /**
+         * Create a new window with a new flutter engine, using the given properties.
+         * The initial payload is kept for the new window until it takes it. (See takeInitialPayload())
+         *
+         * Returns false if the ID is already taken, or the window cannot be created.
+         */
+        static bool createWindow(std::string id, WindowSpec spec, FlValue *initialPayload = nullptr);
 
         /**
          * Change the layer of the window to the given layer.
@@ -131,6 +489,12 @@ namespace FLWM
          */
         void setTitle(std::string title);
 
+        /**
+         * Set the namespace of the layer window. The namespace of a mapped layer surface cannot
+         * be changed, so the window is remapped if it is shown.
+         */
+        void setLayerNamespace(std::string layerNamespace);
+
         /**
          * Set the margin of the window to the given values.
          */
@@ -143,6 +507,9 @@ namespace FLWM
 
         /**
          * Enable the transparency of the window. So that the window can have a transparent background.
+         *
+         * The visual of a realized window cannot be changed, so the windows created by the plugin
+         * should use the transparent option of createWindow() instead.
          */
         void enableTransparency();
 
@@ -167,18 +534,72 @@ namespace FLWM
          */
         void setLayerExclusiveZone(int length);
 
+        /**
+         * Returns the exclusive zone of the window set by setLayerExclusiveZone(). (0 by default)
+         */
+        int getLayerExclusiveZone();
+
+        /**
+         * Animate the size, layer margins and exclusive zone of the window to the given target,
+         * on the platform side. The values that are not set in the target are not changed.
+         * A "geometryAnimationEnd" event is emitted when the animation is finished or stopped.
+         */
+        void animateGeometry(int animationId, WindowGeometry target, unsigned int durationMs,
+                             AnimationCurve curve);
+
+        /**
+         * Stop the geometry animation of the window at its current geometry.
+         */
+        void stopGeometryAnimation();
+
+        /**
+         * Returns the initial payload given to createWindow() for this window, and releases it.
+         * The returned value is a new reference. (NULL if there is no payload, or it is taken)
+         */
+        FlValue *takeInitialPayload();
+
+        /**
+         * Set the color painted by the native window. (See WindowSpec.isNative)
+         */
+        void setNativeColor(uint32_t color);
+
+        /**
+         * Set if the window can be closed while it is hidden, when the system is under memory
+         * pressure. (See MemoryMonitor)
+         */
+        void setEvictable(bool evictable);
+
+        bool isEvictable();
+
+        /**
+         * Tell the engine of the window that the memory is low, so that it releases its caches.
+         */
+        void notifyMemoryPressure();
+
+        /**
+         * Returns the GTK window of this window.
+         */
+        GtkWindow *getGtkWindow();
+
         /**
          * Close the window and free all resources associated with the window.
          */
         void closeWindow();
 
         /**
-         * Hide the window from the screen.
+         * Hide the window from the screen. The engine of the window is paused while it is hidden.
+         * If notifyMemoryPressure is true, the engine is also told to release its caches.
+         *
+         * If soft is true, the surface of a transparent layer window is kept mapped. Its view is
+         * hidden, and its input region, keyboard interactivity and exclusive zone are cleared
+         * until it is shown, so showing it again is a single commit instead of a new configure of
+         * the layer surface. The engine keeps running, so that the window shows its latest
+         * content. Other windows are hidden as usual.
          */
-        void hideWindow();
+        void hideWindow(bool notifyMemoryPressure = false, bool soft = false);
 
         /**
-         * Show a window that is already hidden.
+         * Show a window that is already hidden. (Also after a soft hide)
          */
         void showWindow();
 
@@ -194,8 +615,10 @@ namespace FLWM
 
         /**
          * Create a new method channel in the platform side for this window.
+         * The destroyNotify is called with the userData when the channel is removed.
          */
-        void createMethodChannel(std::string channelName, FlMethodChannelMethodCallHandler handler, void *userData);
+        void createMethodChannel(std::string channelName, FlMethodChannelMethodCallHandler handler, void *userData,
+                                 GDestroyNotify destroyNotify);
 
         /**
          * Send a method call to the given channel.
@@ -219,14 +642,83 @@ namespace FLWM
          */
         void subtractInputRegion(int x, int y, int width, int height);
 
+        /**
+         * Replace the input region of the window with the set pixels of the given mask.
+         * The pixelRatio is the number of mask pixels in a pixel of the window surface.
+         *
+         * Returns false if the mask is not valid.
+         */
+        bool setInputRegionMask(const Mask &mask, double pixelRatio);
+
+        /**
+         * Remove the opaque region of the window, so that the whole window is blended.
+         */
+        void clearOpaqueRegion();
+
+        /**
+         * Add the given region to the opaque region of the window. The region must not have any
+         * translucent pixels, since the compositor may not draw the content below it.
+         */
+        void addOpaqueRegion(int x, int y, int width, int height);
+
+        /**
+         * Subtract the given region from the opaque region of the window.
+         */
+        void subtractOpaqueRegion(int x, int y, int width, int height);
+
+        /**
+         * Returns the scale of the window as a map with the preferred scale sent by the compositor
+         * ("scale") and the integer scale of the buffers rendered by GDK ("bufferScale").
+         */
+        FlValue *getScale();
+
+        /**
+         * Start or stop collecting the frame timing of the window. The statistics are reset when
+         * the collection is started.
+         */
+        void setFrameTelemetry(bool enabled);
+
+        /**
+         * Returns the frame timing statistics of the window. (presented/discarded/dropped frame
+         * counts and the frame interval histogram)
+         */
+        FlValue *getFrameStats();
+
+        /**
+         * Returns the resident memory of the process ("residentBytes") and the growth of it while
+         * each engine was started ("engineStartBytes", mapped with the window IDs).
+         */
+        static FlValue *getMemoryUsage();
+
         /**
          * Method to get monitor list
          */
         FlValue *getMonitorList();
+
+        /**
+         * Returns the details of all monitors (index, connector, geometry, workarea, scale, etc.)
+         */
+        static FlValue *getMonitors();
         /**
          * Method to set monitor list
          */
         void setMonitor(int monitor_index);
+
+        /**
+         * Move the layer window to the given monitor. A "monitorMigrated" event is emitted when
+         * the window is drawn on the monitor.
+         *
+         * The view of the window cannot be moved into another GTK window without restarting its
+         * engine, so the window is remapped onto the monitor. It disappears from the old monitor
+         * while it is remapped, and its first frame on the new monitor may be drawn at the old size.
+         *
+         * An empty placeholder with the same layer state is shown on the monitor first, so that
+         * the other surfaces there make room for the window once, instead of being reflowed again
+         * when the window arrives. The engine is not paused while the window is remapped.
+         *
+         * Returns false if the window is not a layer window, or the monitor is not found.
+         */
+        bool migrateToMonitor(int monitorIndex);
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include <logger/logger.h>
+#include <monitor_manager/monitor_manager.h>
+#include <window_manager/window_replicator.h>
+
+/**
+ * Static member initialization
+ */
+std::map<std::string, FLWM::ReplicatedWindow>
+    FLWM::WindowReplicator::replicatedWindows;
+bool FLWM::WindowReplicator::isListening = false;
+
+/**
+ * Returns a key that identifies the given monitor across the monitor changes.
+ * The index of a monitor changes when other monitors are disconnected, so the
+ * connector name is used if available.
+ */
+std::string _getMonitorKey(const FLWM::Monitor &monitor) {
+  if (!monitor.connector.empty()) {
+    return monitor.connector;
+  }
+
+  return monitor.model + "@" + std::to_string(monitor.geometry.x) + "," +
+         std::to_string(monitor.geometry.y);
+}
+
+void FLWM::WindowReplicator::create(std::string id, WindowSpec spec) {
+  if (exists(id)) {
+    FLWM_LOG_ERROR(
+        "The ID is already taken! Cannot create new replicated window: %s",
+        id.c_str());
+    return;
+  }
+
+  if (!isListening) {
+    FLWM::MonitorManager::addListener(
+        []() { FLWM::WindowReplicator::reconcile(); });
+    isListening = true;
+  }
+
+  /// The monitor of a window can be changed only for the layer windows.
+  spec.isLayer = true;
+
+  ReplicatedWindow replicatedWindow;
+  replicatedWindow.id = id;
+  replicatedWindow.spec = spec;
+  replicatedWindow.instanceCounter = 0;
+  replicatedWindows[id] = replicatedWindow;
+
+  reconcile(replicatedWindows[id]);
+}
+
+void FLWM::WindowReplicator::close(std::string id) {
+  auto iter = replicatedWindows.find(id);
+  if (iter == replicatedWindows.end()) {
+    return;
+  }
+
+  for (auto const &[key, windowId] : iter->second.instances) {
+    if (FLWM::WindowManager::hasWindow(windowId)) {
+      FLWM::WindowManager(windowId).closeWindow();
+    }
+  }
+
+  for (std::string &windowId : iter->second.parkedInstances) {
+    if (FLWM::WindowManager::hasWindow(windowId)) {
+      FLWM::WindowManager(windowId).closeWindow();
+    }
+  }
+
+  replicatedWindows.erase(iter);
+}
+
+bool FLWM::WindowReplicator::exists(std::string id) {
+  return replicatedWindows.find(id) != replicatedWindows.end();
+}
+
+FlValue *FLWM::WindowReplicator::getInstances(std::string id) {
+  FlValue *result = fl_value_new_map();
+
+  auto iter = replicatedWindows.find(id);
+  if (iter == replicatedWindows.end()) {
+    return result;
+  }
+
+  for (const Monitor &monitor : FLWM::MonitorManager::getMonitorRecords()) {
+    auto instance = iter->second.instances.find(_getMonitorKey(monitor));
+    if (instance != iter->second.instances.end()) {
+      fl_value_set_string_take(result, instance->second.c_str(),
+                               fl_value_new_int(monitor.index));
+    }
+  }
+
+  return result;
+}
+
+void FLWM::WindowReplicator::reconcile() {
+  for (auto &[id, replicatedWindow] : replicatedWindows) {
+    reconcile(replicatedWindow);
+  }
+}
+
+void FLWM::WindowReplicator::reconcile(ReplicatedWindow &replicatedWindow) {
+  std::map<std::string, const Monitor *> monitors;
+  for (const Monitor &monitor : FLWM::MonitorManager::getMonitorRecords()) {
+    monitors[_getMonitorKey(monitor)] = &monitor;
+  }
+
+  std::map<std::string, std::string> &instances = replicatedWindow.instances;
+  std::vector<std::string> &parkedInstances = replicatedWindow.parkedInstances;
+
+  /// Forget the instances that are closed by someone else.
+  for (auto iter = instances.begin(); iter != instances.end();) {
+    if (FLWM::WindowManager::hasWindow(iter->second)) {
+      ++iter;
+    } else {
+      iter = instances.erase(iter);
+    }
+  }
+  for (auto iter = parkedInstances.begin(); iter != parkedInstances.end();) {
+    if (FLWM::WindowManager::hasWindow(*iter)) {
+      ++iter;
+    } else {
+      iter = parkedInstances.erase(iter);
+    }
+  }
+
+  /// Hide the instances whose monitor is disconnected, and keep them for reuse.
+  /// Their engines release their caches, since they may stay hidden for long.
+  for (auto iter = instances.begin(); iter != instances.end();) {
+    if (monitors.find(iter->first) != monitors.end()) {
+      ++iter;
+      continue;
+    }
+
+    FLWM::WindowManager(iter->second).hideWindow(true);
+    parkedInstances.push_back(iter->second);
+    iter = instances.erase(iter);
+  }
+
+  /// Show an instance on each monitor that does not have one. The hidden
+  /// instances are reused first, since their engines are already running.
+  for (auto const &[key, monitor] : monitors) {
+    if (instances.find(key) != instances.end()) {
+      continue;
+    }
+
+    if (!parkedInstances.empty()) {
+      std::string windowId = parkedInstances.back();
+      parkedInstances.pop_back();
+
+      FLWM::WindowManager manager(windowId);
+      manager.setMonitor(monitor->index);
+      manager.showWindow();
+
+      instances[key] = windowId;
+    } else {
+      /// Skip the IDs taken by the other windows.
+      std::string windowId;
+      do {
+        windowId = replicatedWindow.id + "#" +
+                   std::to_string(++replicatedWindow.instanceCounter);
+      } while (FLWM::WindowManager::hasWindow(windowId));
+
+      WindowSpec spec = replicatedWindow.spec;
+      spec.monitor = monitor->index;
+      if (!FLWM::WindowManager::createWindow(windowId, spec)) {
+        continue;
+      }
+
+      g_signal_connect(FLWM::WindowManager(windowId).getGtkWindow(),
+                       "delete-event", G_CALLBACK(onInstanceDelete), NULL);
+      instances[key] = windowId;
+    }
+  }
+
+  /// Close the oldest hidden instances exceeding the limit.
+  while (parkedInstances.size() > maxParkedInstances) {
+    FLWM::WindowManager(parkedInstances.front()).closeWindow();
+    parkedInstances.erase(parkedInstances.begin());
+  }
+}
+
+gboolean FLWM::WindowReplicator::onInstanceDelete(GtkWidget *widget,
+                                                  GdkEvent *event,
+                                                  gpointer userData) {
+  for (auto &[id, replicatedWindow] : replicatedWindows) {
+    std::map<std::string, std::string> &instances = replicatedWindow.instances;
+    for (auto iter = instances.begin(); iter != instances.end(); ++iter) {
+      /// The window is removed from the window manager before it is closed by
+      /// closeWindow(), so such windows are closed as usual.
+      if (!FLWM::WindowManager::hasWindow(iter->second)) {
+        continue;
+      }
+
+      FLWM::WindowManager manager(iter->second);
+      if (GTK_WIDGET(manager.getGtkWindow()) != widget) {
+        continue;
+      }
+
+      /// The monitor is removed from the monitor list later, so the instance
+      /// is parked here, before it is destroyed.
+      manager.hideWindow(true);
+      replicatedWindow.parkedInstances.push_back(iter->second);
+      instances.erase(iter);
+      return TRUE;
+    }
+
+    for (const std::string &windowId : replicatedWindow.parkedInstances) {
+      if (FLWM::WindowManager::hasWindow(windowId) &&
+          GTK_WIDGET(FLWM::WindowManager(windowId).getGtkWindow()) == widget) {
+        return TRUE;
+      }
+    }
+  }
+
+  return FALSE;
+}
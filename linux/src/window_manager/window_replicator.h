@@ -0,0 +1,102 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <window_manager/window_manager.h>
+
+namespace FLWM
+{
+    /**
+     * A window that is replicated on every monitor.
+     */
+    struct ReplicatedWindow
+    {
+        /**
+         * The ID given to the replicated window. The instances have their own window IDs.
+         */
+        std::string id;
+
+        /**
+         * The properties used to create each instance.
+         */
+        WindowSpec spec;
+
+        /**
+         * The instances shown on the monitors, mapped with the monitor key.
+         */
+        std::map<std::string, std::string> instances;
+
+        /**
+         * The hidden instances whose monitor is disconnected. These are reused when a new monitor
+         * is connected, so that the engine of the instance does not need to be started again.
+         */
+        std::vector<std::string> parkedInstances;
+
+        /**
+         * A counter used to generate the IDs of the instances.
+         */
+        unsigned int instanceCounter;
+    };
+
+    /**
+     * Creates an instance of a window on every monitor, and creates or removes the instances
+     * when the monitors are connected or disconnected.
+     */
+    class WindowReplicator
+    {
+    public:
+        /**
+         * The maximum number of hidden instances kept for reuse, for each replicated window.
+         * The instances exceeding this limit are closed.
+         */
+        static constexpr size_t maxParkedInstances = 2;
+
+        /**
+         * Create a window with the given properties on every monitor.
+         */
+        static void create(std::string id, WindowSpec spec);
+
+        /**
+         * Close all instances of the replicated window with the given ID.
+         */
+        static void close(std::string id);
+
+        /**
+         * Returns if a replicated window with the given ID exists.
+         */
+        static bool exists(std::string id);
+
+        /**
+         * Returns a map of the window IDs of the instances, to the index of the monitor on which
+         * the instance is shown.
+         */
+        static FlValue *getInstances(std::string id);
+
+    private:
+        /**
+         * The replicated windows, mapped with their IDs.
+         */
+        static std::map<std::string, ReplicatedWindow> replicatedWindows;
+
+        /**
+         * If the replicator is listening to the monitor changes.
+         */
+        static bool isListening;
+
+        /**
+         * Create, reuse or park the instances of all replicated windows, to match the monitors.
+         */
+        static void reconcile();
+
+        static void reconcile(ReplicatedWindow &replicatedWindow);
+
+        /**
+         * Called when an instance is asked to close. The compositor closes the layer surface of
+         * an instance when its monitor is disconnected, so the instance is parked instead of
+         * being destroyed.
+         */
+        static gboolean onInstanceDelete(GtkWidget *widget, GdkEvent *event, gpointer userData);
+    };
+}
@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <input_mask/input_mask.h>
+
+namespace FLWM {
+namespace test {
+
+/// The pixels of a mask, kept along with the bytes in the format of the mask.
+struct TestMask {
+  std::vector<uint8_t> bytes;
+  std::vector<bool> pixels;
+  Mask mask;
+};
+
+/// Create a mask of the given format, with the alpha of each pixel given by
+/// alphaAt. (For MASK_FORMAT_BITS, a pixel is set if its alpha is not 0)
+template <typename AlphaAt>
+TestMask makeMask(int width, int height, MaskFormat format, uint8_t threshold,
+                  AlphaAt alphaAt) {
+  TestMask result;
+  size_t rowLength = InputMask::getRowLength(width, format);
+  result.bytes.assign(rowLength * height, 0);
+  result.pixels.assign((size_t)width * height, false);
+
+  for (int y = 0; y < height; y++) {
+    uint8_t *row = result.bytes.data() + rowLength * y;
+    for (int x = 0; x < width; x++) {
+      uint8_t alpha = alphaAt(x, y);
+      bool isSet;
+
+      switch (format) {
+      case MASK_FORMAT_RGBA8:
+        /// The color channels are filled, so that only the alpha is read.
+        row[x * 4] = 0xFF;
+        row[x * 4 + 1] = 0xFF;
+        row[x * 4 + 2] = 0xFF;
+        row[x * 4 + 3] = alpha;
+        isSet = alpha > threshold;
+        break;
+      case MASK_FORMAT_BITS:
+        isSet = alpha != 0;
+        row[x / 8] |= (uint8_t)(isSet << (x % 8));
+        break;
+      default:
+        row[x] = alpha;
+        isSet = alpha > threshold;
+        break;
+      }
+
+      result.pixels[(size_t)y * width + x] = isSet;
+    }
+  }
+
+  result.mask = {result.bytes.data(), result.bytes.size(), width,
+                 height,              format,              threshold};
+  return result;
+}
+
+/// Convert the pixels into rects one pixel at a time, in the same banded form
+/// as InputMask::toRects().
+std::vector<MaskRect> referenceRects(const TestMask &testMask, bool coarse) {
+  const Mask &mask = testMask.mask;
+  std::vector<MaskRect> rects;
+
+  auto rowRuns = [&](int y) {
+    std::vector<std::pair<int, int>> runs;
+    for (int x = 0; x < mask.width;) {
+      if (!testMask.pixels[(size_t)y * mask.width + x]) {
+        x++;
+        continue;
+      }
+
+      int start = x;
+      while (x < mask.width && testMask.pixels[(size_t)y * mask.width + x]) {
+        x++;
+      }
+      runs.push_back({start, x});
+    }
+    return runs;
+  };
+
+  auto addBand = [&](const std::vector<std::pair<int, int>> &runs, int y,
+                     int height) {
+    if (runs.empty()) {
+      return;
+    }
+
+    if (coarse) {
+      rects.push_back({runs.front().first, y,
+                       runs.back().second - runs.front().first, height});
+      return;
+    }
+
+    for (auto const &[start, end] : runs) {
+      rects.push_back({start, y, end - start, height});
+    }
+  };
+
+  std::vector<std::pair<int, int>> band;
+  int bandStart = 0;
+  for (int y = 0; y < mask.height; y++) {
+    std::vector<std::pair<int, int>> runs = rowRuns(y);
+    if (y > 0 && runs == band) {
+      continue;
+    }
+
+    addBand(band, bandStart, y - bandStart);
+    band = runs;
+    bandStart = y;
+  }
+  addBand(band, bandStart, mask.height - bandStart);
+
+  return rects;
+}
+
+/// Check the rects of the mask against the reference.
+void expectRects(const TestMask &testMask) {
+  std::vector<MaskRect> rects;
+  ASSERT_TRUE(InputMask::toRects(testMask.mask, rects));
+
+  std::vector<MaskRect> expected = referenceRects(testMask, false);
+  if (expected.size() > InputMask::maxRects) {
+    expected = referenceRects(testMask, true);
+  }
+
+  ASSERT_EQ(rects.size(), expected.size());
+  for (size_t i = 0; i < rects.size(); i++) {
+    EXPECT_EQ(rects[i], expected[i])
+        << "rect " << i << " of a " << testMask.mask.width << "x"
+        << testMask.mask.height << " mask";
+  }
+}
+
+/// The widths around the 16 pixel blocks, so that every mask has full blocks,
+/// a tail, or both.
+const int widths[] = {1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 47, 63, 100, 129};
+
+const MaskFormat formats[] = {MASK_FORMAT_ALPHA8, MASK_FORMAT_RGBA8,
+                              MASK_FORMAT_BITS};
+
+TEST(InputMaskTest, MatchesReferenceForRandomMasks) {
+  std::mt19937 random(42);
+
+  for (MaskFormat format : formats) {
+    for (int width : widths) {
+      /// A sparse mask has runs that start and end in the middle of the
+      /// blocks, and a dense one has blocks that are fully set.
+      for (int density : {10, 50, 90}) {
+        std::uniform_int_distribution<int> percent(0, 99);
+        std::uniform_int_distribution<int> alpha(0, 255);
+
+        TestMask testMask =
+            makeMask(width, 5, format, 127, [&](int x, int y) -> uint8_t {
+              if (percent(random) >= density) {
+                return 0;
+              }
+              return (uint8_t)std::max(alpha(random), 128);
+            });
+        expectRects(testMask);
+      }
+    }
+  }
+}
+
+TEST(InputMaskTest, MatchesReferenceForShapes) {
+  for (MaskFormat format : formats) {
+    for (int width : widths) {
+      /// A circle has runs of a different length in each row, and rows with
+      /// the same runs merged into bands.
+      int height = 37;
+      TestMask testMask =
+          makeMask(width, height, format, 0, [&](int x, int y) -> uint8_t {
+            int dx = 2 * x - width, dy = 2 * y - height;
+            return dx * dx + dy * dy < width * width ? 255 : 0;
+          });
+      expectRects(testMask);
+
+      /// Vertical stripes cross the block boundaries in every row.
+      testMask = makeMask(width, 3, format, 0, [](int x, int y) -> uint8_t {
+        return (x / 3) % 2 == 0 ? 255 : 0;
+      });
+      expectRects(testMask);
+    }
+  }
+}
+
+TEST(InputMaskTest, ComparesAlphaWithThreshold) {
+  for (MaskFormat format : {MASK_FORMAT_ALPHA8, MASK_FORMAT_RGBA8}) {
+    for (int threshold : {0, 1, 127, 128, 254}) {
+      /// Every alpha near the threshold is used in each block, so both the
+      /// equal and the greater alpha are checked in the vector compare.
+      TestMask testMask =
+          makeMask(50, 4, format, (uint8_t)threshold,
+                   [&](int x, int y) -> uint8_t {
+                     int alpha = threshold - 1 + (x + y) % 3;
+                     return (uint8_t)std::clamp(alpha, 0, 255);
+                   });
+      expectRects(testMask);
+    }
+
+    /// The alpha 255 is set with the threshold 254, and the alpha with the
+    /// high bit set is not taken as negative.
+    TestMask testMask = makeMask(
+        20, 1, format, 254, [](int x, int y) -> uint8_t { return 255; });
+    std::vector<MaskRect> rects;
+    ASSERT_TRUE(InputMask::toRects(testMask.mask, rects));
+    ASSERT_EQ(rects.size(), 1u);
+    EXPECT_EQ(rects[0], (MaskRect{0, 0, 20, 1}));
+
+    /// No alpha is greater than the threshold 255.
+    testMask = makeMask(20, 1, format, 255,
+                        [](int x, int y) -> uint8_t { return 255; });
+    ASSERT_TRUE(InputMask::toRects(testMask.mask, rects));
+    EXPECT_TRUE(rects.empty());
+  }
+}
+
+TEST(InputMaskTest, ReadsBitsFromTheLeastSignificantBit) {
+  /// 0b00000101, 0b10000000: pixels 0, 2 and 15 are set.
+  std::vector<uint8_t> bytes = {0x05, 0x80, 0x00};
+  Mask mask = {bytes.data(), bytes.size(), 17, 1, MASK_FORMAT_BITS, 0};
+
+  std::vector<MaskRect> rects;
+  ASSERT_TRUE(InputMask::toRects(mask, rects));
+
+  std::vector<MaskRect> expected = {
+      {0, 0, 1, 1}, {2, 0, 1, 1}, {15, 0, 1, 1}};
+  EXPECT_EQ(rects, expected);
+}
+
+TEST(InputMaskTest, SimplifiesNoisyMasksIntoBands) {
+  /// A checkerboard of single pixels has far more rects than the limit.
+  TestMask testMask =
+      makeMask(200, 100, MASK_FORMAT_ALPHA8, 0,
+               [](int x, int y) -> uint8_t { return (x + y) % 2 ? 255 : 0; });
+  ASSERT_GT(referenceRects(testMask, false).size(), InputMask::maxRects);
+
+  std::vector<MaskRect> rects;
+  ASSERT_TRUE(InputMask::toRects(testMask.mask, rects));
+  EXPECT_LE(rects.size(), InputMask::maxRects);
+  EXPECT_EQ(rects, referenceRects(testMask, true));
+}
+
+TEST(InputMaskTest, RejectsShortData) {
+  std::vector<uint8_t> bytes(15, 255);
+  Mask mask = {bytes.data(), bytes.size(), 4, 4, MASK_FORMAT_ALPHA8, 0};
+
+  std::vector<MaskRect> rects;
+  EXPECT_FALSE(InputMask::toRects(mask, rects));
+
+  /// An empty mask does not need any data.
+  Mask empty = {nullptr, 0, 0, 0, MASK_FORMAT_ALPHA8, 0};
+  EXPECT_TRUE(InputMask::toRects(empty, rects));
+  EXPECT_TRUE(rects.empty());
+}
+
+} // namespace test
+} // namespace FLWM